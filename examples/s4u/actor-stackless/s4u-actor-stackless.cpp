@@ -0,0 +1,126 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* This example shows how to write actors that have no stack of their own.
+ *
+ * The code of such actors is a step function, called again each time the activity it awaits is finished. Their state
+ * must thus be saved in the function object between the calls, as in a state machine. They can interact freely with
+ * the regular actors, such as the pinger below.
+ */
+
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_actor_stackless, "Messages specific for this s4u example");
+
+/* A regular actor, that sends a ping and waits for the answer */
+static void pinger(simgrid::s4u::Mailbox* in, simgrid::s4u::Mailbox* out)
+{
+  double* payload = new double(simgrid::s4u::Engine::get_clock());
+  XBT_INFO("Ping from the regular actor");
+  out->put(payload, 1e6);
+
+  double* sent_time = static_cast<double*>(in->get());
+  XBT_INFO("Pong received after %f seconds", simgrid::s4u::Engine::get_clock() - *sent_time);
+  delete sent_time;
+}
+
+/* A stackless actor, that answers to the ping, computes a bit and then sleeps */
+class Ponger {
+  enum class State { RECEIVE_PING, SEND_PONG, COMPUTE, SLEEP, DONE };
+  State state_ = State::RECEIVE_PING;
+  simgrid::s4u::Mailbox* in_;
+  simgrid::s4u::Mailbox* out_;
+  simgrid::s4u::CommPtr comm_;
+  double* payload_ = nullptr;
+
+public:
+  Ponger(simgrid::s4u::Mailbox* in, simgrid::s4u::Mailbox* out) : in_(in), out_(out) {}
+
+  /* Called each time the actor is scheduled: each case starts an activity and awaits it before returning */
+  void operator()()
+  {
+    switch (state_) {
+      case State::RECEIVE_PING:
+        comm_  = in_->get_async(reinterpret_cast<void**>(&payload_));
+        state_ = State::SEND_PONG;
+        comm_->await();
+        break;
+
+      case State::SEND_PONG:
+        XBT_INFO("Ping received after %f seconds", simgrid::s4u::Engine::get_clock() - *payload_);
+        delete payload_;
+        payload_ = new double(simgrid::s4u::Engine::get_clock());
+        comm_    = out_->put_async(payload_, 1e6);
+        state_   = State::COMPUTE;
+        comm_->await();
+        break;
+
+      case State::COMPUTE:
+        XBT_INFO("Pong sent, now computing");
+        state_ = State::SLEEP;
+        simgrid::s4u::this_actor::exec_async(1e9)->await();
+        break;
+
+      case State::SLEEP:
+        XBT_INFO("Computed, now sleeping");
+        state_ = State::DONE;
+        simgrid::s4u::this_actor::await_for(1);
+        break;
+
+      case State::DONE: // Returning without awaiting anything terminates the actor
+        XBT_INFO("Woken up. Goodbye now!");
+        break;
+    }
+  }
+};
+
+/* A stackless daemon, that computes forever and gets killed once the other actors are done */
+static void create_daemon()
+{
+  int step = 0;
+  simgrid::s4u::Actor::create_stackless("daemon", simgrid::s4u::Host::by_name("Boivin"), [step]() mutable {
+    if (step == 0) {
+      simgrid::s4u::Actor::self()->daemonize();
+      simgrid::s4u::this_actor::on_exit([](bool failed) { XBT_INFO("Daemon killed: %s", failed ? "yes" : "no"); });
+    } else {
+      XBT_INFO("Computation #%d done", step);
+    }
+    step++;
+    simgrid::s4u::this_actor::exec_async(1e9)->await();
+  });
+}
+
+/* A lot of tiny stackless actors, that sleep and exit */
+static void create_sleepers(int count)
+{
+  for (int i = 0; i < count; i++) {
+    bool awake = false;
+    simgrid::s4u::Actor::create_stackless("sleeper", simgrid::s4u::Host::by_name("Fafard"), [awake]() mutable {
+      if (not awake) {
+        awake = true;
+        simgrid::s4u::this_actor::await_for(1 + simgrid::s4u::this_actor::get_pid() % 10);
+      }
+    });
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file\n\tExample: %s msg_platform.xml\n", argv[0], argv[0]);
+  e.load_platform(argv[1]);
+
+  simgrid::s4u::Mailbox* ping = simgrid::s4u::Mailbox::by_name("ping");
+  simgrid::s4u::Mailbox* pong = simgrid::s4u::Mailbox::by_name("pong");
+  simgrid::s4u::Actor::create("pinger", simgrid::s4u::Host::by_name("Tremblay"), pinger, pong, ping);
+  simgrid::s4u::Actor::create_stackless("ponger", simgrid::s4u::Host::by_name("Jupiter"), Ponger(ping, pong));
+  create_daemon();
+  create_sleepers(10000);
+
+  e.run();
+
+  XBT_INFO("Simulation ended at %f", e.get_clock());
+  return 0;
+}
@@ -0,0 +1,98 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Ping-pong of actual data buffers, to compare two ways of passing them to the receiver:
+ *  - copy: the sender keeps its buffer, so it sends a copy of it, that the receiver copies in its own buffer;
+ *  - move: the sender hands its buffer over to the receiver with Comm::set_src_data_moved(), so nothing is copied.
+ * Both must give the same simulation. Run it on large buffers to see the difference in the duration of the simulation.
+ */
+
+#include <simgrid/s4u.hpp>
+
+#include <cstring>
+#include <string>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_app_pingpong, "Messages specific for this s4u example");
+
+static bool move_buffers = true;
+static size_t size       = 1024 * 1024;
+static int rounds        = 10;
+
+static unsigned char* send_buffer(simgrid::s4u::Mailbox* mailbox, unsigned char* buffer)
+{
+  if (move_buffers) {
+    mailbox->put_init(buffer, size)->set_src_data_moved(buffer, size)->wait();
+    return nullptr; // not ours anymore
+  }
+  unsigned char* copy = new unsigned char[size];
+  memcpy(copy, buffer, size);
+  mailbox->put(copy, size);
+  return buffer;
+}
+
+static unsigned char* receive_buffer(simgrid::s4u::Mailbox* mailbox, unsigned char* buffer)
+{
+  void* data;
+  simgrid::s4u::CommPtr comm = mailbox->get_async(&data);
+  comm->wait();
+  if (move_buffers) {
+    xbt_assert(comm->get_dst_data_size() == size, "Received %zu bytes instead of %zu", comm->get_dst_data_size(), size);
+    return static_cast<unsigned char*>(data); // ours now
+  }
+  memcpy(buffer, data, size);
+  delete[] static_cast<unsigned char*>(data);
+  return buffer;
+}
+
+static void pinger(simgrid::s4u::Mailbox* mailbox_in, simgrid::s4u::Mailbox* mailbox_out)
+{
+  unsigned char* buffer  = new unsigned char[size];
+  unsigned long checksum = 0;
+  for (int i = 0; i < rounds; i++) {
+    memset(buffer, i, size);
+    buffer = send_buffer(mailbox_out, buffer);
+    buffer = receive_buffer(mailbox_in, buffer);
+    checksum += buffer[0] + buffer[size - 1];
+  }
+  delete[] buffer;
+  XBT_INFO("%d round trips of %zu bytes (checksum: %lu)", rounds, size, checksum);
+}
+
+static void ponger(simgrid::s4u::Mailbox* mailbox_in, simgrid::s4u::Mailbox* mailbox_out)
+{
+  unsigned char* buffer = move_buffers ? nullptr : new unsigned char[size];
+  for (int i = 0; i < rounds; i++) {
+    buffer = receive_buffer(mailbox_in, buffer);
+    buffer[size - 1]++;
+    buffer = send_buffer(mailbox_out, buffer);
+  }
+  delete[] buffer;
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file [copy|move [size [rounds]]]\n", argv[0]);
+  e.load_platform(argv[1]);
+  if (argc > 2)
+    move_buffers = std::string(argv[2]) == "move";
+  if (argc > 3)
+    size = std::stoul(argv[3]);
+  if (argc > 4)
+    rounds = std::stoi(argv[4]);
+  xbt_assert(size > 0, "Cannot send empty buffers");
+
+  simgrid::s4u::Mailbox* mb1 = simgrid::s4u::Mailbox::by_name("Mailbox 1");
+  simgrid::s4u::Mailbox* mb2 = simgrid::s4u::Mailbox::by_name("Mailbox 2");
+
+  simgrid::s4u::Actor::create("pinger", simgrid::s4u::Host::by_name("Tremblay"), pinger, mb1, mb2);
+  simgrid::s4u::Actor::create("ponger", simgrid::s4u::Host::by_name("Jupiter"), ponger, mb2, mb1);
+
+  e.run();
+
+  XBT_INFO("Total simulation time: %.3f", e.get_clock());
+
+  return 0;
+}
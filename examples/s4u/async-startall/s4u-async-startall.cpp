@@ -0,0 +1,62 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* This example shows how to start a set of communications at once.
+ *
+ * The sender prepares all the messages it wants to send with simgrid::s4u::Mailbox::put_init(), and starts them all
+ * with simgrid::s4u::Comm::start_all(). This costs a single simcall (and thus a single context switch) instead of one
+ * per message. The receivers do the same with the messages they expect.
+ */
+
+#include "simgrid/s4u.hpp"
+#include <string>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_async_startall, "Messages specific for this s4u example");
+
+static void sender(int messages_count, int receivers_count)
+{
+  std::vector<simgrid::s4u::CommPtr> pending_comms;
+  for (int i = 0; i < messages_count; i++) {
+    simgrid::s4u::Mailbox* mbox = simgrid::s4u::Mailbox::by_name("receiver-" + std::to_string(i % receivers_count));
+    pending_comms.push_back(mbox->put_init(new int(i), 1e6));
+  }
+
+  XBT_INFO("Start %zu messages", pending_comms.size());
+  simgrid::s4u::Comm::start_all(pending_comms);
+  XBT_INFO("Done dispatching all messages");
+
+  simgrid::s4u::Comm::wait_all(&pending_comms);
+  XBT_INFO("Goodbye now!");
+}
+
+static void receiver(int id, int messages_count)
+{
+  simgrid::s4u::Mailbox* mbox = simgrid::s4u::Mailbox::by_name("receiver-" + std::to_string(id));
+  std::vector<int*> payloads(messages_count);
+  std::vector<simgrid::s4u::CommPtr> pending_comms;
+  for (int i = 0; i < messages_count; i++)
+    pending_comms.push_back(mbox->get_init()->set_dst_data(reinterpret_cast<void**>(&payloads[i]), sizeof(void*)));
+  simgrid::s4u::Comm::start_all(pending_comms);
+
+  simgrid::s4u::Comm::wait_all(&pending_comms);
+  for (int* payload : payloads) {
+    XBT_INFO("I got message %d", *payload);
+    delete payload;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file\n", argv[0]);
+  e.load_platform(argv[1]);
+
+  simgrid::s4u::Actor::create("sender", simgrid::s4u::Host::by_name("Tremblay"), sender, 6, 2);
+  simgrid::s4u::Actor::create("receiver", simgrid::s4u::Host::by_name("Ruby"), receiver, 0, 3);
+  simgrid::s4u::Actor::create("receiver", simgrid::s4u::Host::by_name("Perl"), receiver, 1, 3);
+  e.run();
+
+  return 0;
+}
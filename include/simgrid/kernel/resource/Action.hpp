@@ -12,7 +12,9 @@
 
 #include <boost/heap/pairing_heap.hpp>
 #include <boost/optional.hpp>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 static constexpr int NO_MAX_DURATION = -1.0;
 
@@ -25,8 +27,16 @@ typedef boost::heap::pairing_heap<heap_element_type, boost::heap::constant_time_
                                   boost::heap::compare<simgrid::xbt::HeapComparator<heap_element_type>>>
     heap_type;
 
-typedef std::pair<double, simgrid::kernel::resource::Action*> heap_element_type;
-class XBT_PUBLIC ActionHeap : public heap_type {
+/** @brief Heap of the actions, sorted by the date of their next event
+ *
+ * Two implementations are available (see --cfg=surf/action-heap):
+ *  - a boost::heap::pairing_heap, allocating a node per action;
+ *  - a 4-ary heap stored in a contiguous array, each action knowing its position in the array.
+ *
+ * Both are stable: the actions with the same date are popped in the order in which they were inserted or updated, so
+ * the simulation does not depend on the implementation.
+ */
+class XBT_PUBLIC ActionHeap {
   friend Action;
 
 public:
@@ -36,12 +46,43 @@ public:
     normal,        /* this is a normal heap entry stating the date to finish transmitting */
     unset
   };
+  enum class Kind { pairing, four_ary };
+
+  /** Creates a heap of the kind selected by --cfg=surf/action-heap */
+  ActionHeap();
+  explicit ActionHeap(Kind kind) : kind_(kind) {}
+  ActionHeap(const ActionHeap&) = delete;
+  ActionHeap& operator=(const ActionHeap&) = delete;
 
+  Kind get_kind() const { return kind_; }
+  bool empty() const { return kind_ == Kind::pairing ? pairing_heap_.empty() : nodes_.empty(); }
   double top_date() const;
   void insert(Action* action, double date, ActionHeap::Type type);
   void update(Action* action, double date, ActionHeap::Type type);
   void remove(Action* action);
   Action* pop();
+
+private:
+  struct Node {
+    double date;
+    std::uint64_t stamp; // ties are broken by the order of insertion/update
+    Action* action;
+    bool operator<(const Node& other) const
+    {
+      return date < other.date || (date == other.date && stamp < other.stamp);
+    }
+  };
+  static constexpr unsigned arity = 4;
+
+  void place(unsigned pos, const Node& node);
+  void sift_up(unsigned pos);
+  void sift_down(unsigned pos);
+  void erase_at(unsigned pos);
+
+  Kind kind_;
+  heap_type pairing_heap_;
+  std::vector<Node> nodes_;
+  std::uint64_t stamp_ = 0;
 };
 
 /** @details An action is a consumption on a resource (e.g.: a communication for the network).
@@ -223,8 +264,9 @@ private:
   double last_value_                                 = 0;
   kernel::lmm::Variable* variable_                   = nullptr;
 
-  ActionHeap::Type type_                              = ActionHeap::Type::unset;
-  boost::optional<ActionHeap::handle_type> heap_hook_ = boost::none;
+  ActionHeap::Type type_                             = ActionHeap::Type::unset;
+  boost::optional<heap_type::handle_type> heap_hook_ = boost::none; /* position in the pairing heap */
+  int heap_index_                                    = -1;          /* position in the 4-ary heap */
 
 public:
   ActionHeap::Type get_type() const { return type_; }
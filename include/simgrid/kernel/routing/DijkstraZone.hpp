@@ -8,6 +8,8 @@
 
 #include <simgrid/kernel/routing/RoutedZone.hpp>
 
+#include <cstdint>
+#include <vector>
 
 namespace simgrid {
 namespace kernel {
@@ -21,6 +23,10 @@ namespace routing {
  *
  *  This result in rather small platform file, very fast initialization, and very low memory requirements, but somehow
  * long path resolution times.
+ *
+ *  With --cfg=network/dijkstra-precompute:yes, the paths from every source are computed when the zone is sealed (in
+ *  parallel, see --cfg=network/routing-threads) instead, trading memory and initialization time for predictable
+ *  path resolution times.
  */
 class XBT_PRIVATE DijkstraZone : public RoutedZone {
 public:
@@ -34,6 +40,19 @@ private:
   xbt_node_t route_graph_new_node(int id);
   xbt_node_t node_map_search(int id);
   void new_edge(int src_id, int dst_id, RouteCreationArgs* e_route);
+  RouteCreationArgs* get_edge_route(int src_node_id, int dst_node_id);
+  void compute_predecessors(int src_node_id, std::vector<int>& pred_arr);
+  void precompute_predecessors();
+  int get_predecessor(int src_node_id, int node_id);
+
+  /* The graph, as compressed sparse rows: the edges leaving node i are at [edge_start_[i], edge_start_[i + 1]) */
+  std::vector<unsigned int> edge_start_;
+  std::vector<unsigned int> edge_target_;
+  std::vector<RouteCreationArgs*> edge_route_;
+  /* When precomputed, predecessor of each node on the path from each source, at [src * nodes + node]. Only one of
+   * these tables is used, depending on the amount of nodes. */
+  std::vector<uint16_t> short_predecessor_table_;
+  std::vector<uint32_t> predecessor_table_;
 
 public:
   /* For each vertex (node) already in the graph,
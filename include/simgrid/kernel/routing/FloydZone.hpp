@@ -8,6 +8,13 @@
 
 #include <simgrid/kernel/routing/RoutedZone.hpp>
 
+#include <boost/functional/hash.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace simgrid {
 namespace kernel {
 namespace routing {
@@ -20,6 +27,9 @@ namespace routing {
  *
  *  This result in rather small platform file, slow initialization time,  and intermediate memory requirements
  *  (somewhere between the one of @{DijkstraZone} and the one of @{FullZone}).
+ *
+ *  Only the predecessor table is kept once the zone is sealed, using 16 bits integers when the zone is small enough.
+ *  The costs are only needed by the algorithm, and the routes are stored for the declared (one-hop) routes only.
  */
 class XBT_PRIVATE FloydZone : public RoutedZone {
 public:
@@ -34,10 +44,15 @@ public:
   void seal() override;
 
 private:
-  /* vars to compute the Floyd algorithm. */
-  int* predecessor_table_;
-  double* cost_table_;
-  RouteCreationArgs** link_table_;
+  int get_predecessor(unsigned int src, unsigned int dst);
+
+  /* Predecessor of dst on the path from src, at [src + dst * table_size]. Only one of these tables is used. */
+  std::vector<uint16_t> short_predecessor_table_;
+  std::vector<uint32_t> predecessor_table_;
+  /* The declared routes, between adjacent netpoints */
+  std::unordered_map<std::pair<unsigned int, unsigned int>, RouteCreationArgs*,
+                     boost::hash<std::pair<unsigned int, unsigned int>>>
+      link_table_;
 };
 } // namespace routing
 } // namespace kernel
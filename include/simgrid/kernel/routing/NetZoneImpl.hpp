@@ -98,6 +98,7 @@ private:
   std::vector<kernel::routing::NetPoint*> vertices_;
 
   NetZoneImpl* father_ = nullptr;
+  std::vector<NetZoneImpl*> ancestors_; // from the root netzone down to this one (included)
 
   std::vector<NetZoneImpl*> children_; // sub-netzones
 
@@ -106,6 +107,10 @@ public:
   std::vector<kernel::routing::NetPoint*> get_vertices() { return vertices_; }
 
   NetZoneImpl* get_father();
+  /** @brief Depth of this netzone in the hierarchy (the root netzone is at depth 0) */
+  unsigned int get_depth() const { return ancestors_.size() - 1; }
+  /** @brief Retrieves the ancestor found at the given depth (get_ancestor(get_depth()) is this netzone) */
+  NetZoneImpl* get_ancestor(unsigned int depth) const { return ancestors_[depth]; }
 
   std::vector<NetZoneImpl*>* get_children(); // Sub netzones
 
@@ -132,6 +137,15 @@ public:
   static void get_global_route(routing::NetPoint* src, routing::NetPoint* dst,
                                /* OUT */ std::vector<resource::LinkImpl*>& links, double* latency);
 
+  /** @brief Forgets the routes computed so far, after a change in the platform */
+  static void clear_route_cache();
+
+private:
+  /* @brief Same as get_global_route, without using the route cache */
+  static void compute_global_route(routing::NetPoint* src, routing::NetPoint* dst,
+                                   /* OUT */ std::vector<resource::LinkImpl*>& links, double* latency);
+
+public:
   virtual void get_graph(xbt_graph_t graph, std::map<std::string, xbt_node_t>* nodes,
                          std::map<std::string, xbt_edge_t>* edges) = 0;
   enum class RoutingMode {
@@ -191,6 +191,21 @@ public:
     return create(name, host, std::bind(std::move(code), std::move(args)...));
   }
 
+  /** Create an actor that has no stack of its own, from a step function
+   *
+   * The step function is called each time the actor is scheduled, on the stack of maestro. It must not call any
+   * blocking function, but it can start activities, and await at most one of them before returning (with
+   * Comm::await(), Exec::await() or this_actor::await_for()). It is called again once the awaited activity is finished,
+   * and the actor terminates when it returns without awaiting anything. The state of the actor must thus be saved in
+   * the function object between the calls. Such actors cost much less memory than the usual ones, and switching to
+   * them is a mere function call.
+   */
+  static ActorPtr create_stackless(const std::string& name, s4u::Host* host, const std::function<void()>& code);
+  template <class F> static ActorPtr create_stackless(const std::string& name, s4u::Host* host, F code)
+  {
+    return create_stackless(name, host, std::function<void()>(std::move(code)));
+  }
+
   // Create actor from function name:
   static ActorPtr create(const std::string& name, s4u::Host* host, const std::string& function,
                          std::vector<std::string> args);
@@ -313,6 +328,10 @@ XBT_PUBLIC void sleep_for(double duration);
 /** Block the current actor sleeping until the specified timestamp (may throw hostFailure) */
 XBT_PUBLIC void sleep_until(double timeout);
 
+/** Block the current stackless actor sleeping for that amount of seconds (see Actor::create_stackless()).
+ *  This returns right away: the code of the actor is called again when the actor wakes up. */
+XBT_PUBLIC void await_for(double duration);
+
 template <class Rep, class Period> inline void sleep_for(std::chrono::duration<Rep, Period> duration)
 {
   auto seconds = std::chrono::duration_cast<SimulationClockDuration>(duration);
@@ -44,6 +44,9 @@ public:
   friend Mailbox; // Factory of comms
 
   virtual ~Comm();
+  /* The comms are allocated in a pool, since they are created at a high rate */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
 
   static xbt::signal<void(Actor const&)> on_sender_start;
   static xbt::signal<void(Actor const&)> on_receiver_start;
@@ -60,11 +63,19 @@ public:
   /*! take a vector s4u::CommPtr and return the rank of the first finished one (or -1 if none is done). */
   static int test_any(std::vector<CommPtr> * comms);
 
+  /*! Start all the given communications at once, in a single simcall instead of one per communication */
+  static void start_all(const std::vector<CommPtr>& comms);
+
   Comm* start() override;
   Comm* wait() override;
   Comm* wait_for(double timeout) override;
   Comm* cancel() override;
   bool test() override;
+  /** Block the calling stackless actor until the communication is finished (see Actor::create_stackless()).
+   *
+   * This returns right away: the code of the actor must return after this call, and it is called again once the
+   * communication is finished. */
+  void await();
 
   /** Start the comm, and ignore its result. It can be completely forgotten after that. */
   Comm* detach();
@@ -102,6 +113,14 @@ public:
    * in the simulated world, or the opposite.
    */
   CommPtr set_src_data(void* buff, size_t size);
+  /** Specify the data to send and its size, and hand this buffer over to the receiver instead of copying it.
+   *
+   * The receiver gets the address of the buffer (as with @ref Mailbox::put()), and its size with
+   * @ref get_dst_data_size(). Once the communication is started, the sender must neither use nor free the buffer. Once
+   * the communication succeeded, the buffer belongs to the receiver. If the communication fails before that, the
+   * buffer remains to the sender, or is passed to the clean function of detached communications.
+   */
+  CommPtr set_src_data_moved(void* buff, size_t size);
 
   /** Specify where to receive the data.
    *
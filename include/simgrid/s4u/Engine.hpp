@@ -127,6 +127,11 @@ public:
   std::vector<kernel::routing::NetPoint*> get_all_netpoints();
   kernel::routing::NetPoint* netpoint_by_name_or_null(const std::string& name);
 
+  /** @brief Amount of route lookups answered by the route cache (see the network/route-cache option) */
+  unsigned long get_route_cache_hits();
+  /** @brief Amount of route lookups that had to be computed by the routing zones */
+  unsigned long get_route_cache_misses();
+
   NetZone* get_netzone_root();
   void set_netzone_root(NetZone* netzone);
 
@@ -53,6 +53,11 @@ public:
   Exec* wait() override;
   Exec* wait_for(double timeout) override;
   bool test() override;
+  /** Block the calling stackless actor until the execution is finished (see Actor::create_stackless()).
+   *
+   * This returns right away: the code of the actor must return after this call, and it is called again once the
+   * execution is finished. */
+  void await();
 
   ExecPtr set_bound(double bound);
   ExecPtr set_name(const std::string& name);
@@ -70,6 +70,8 @@ XBT_PUBLIC int SIMIX_context_get_parallel_threshold();
 XBT_PUBLIC void SIMIX_context_set_parallel_threshold(int threshold);
 XBT_PUBLIC e_xbt_parmap_mode_t SIMIX_context_get_parallel_mode();
 XBT_PUBLIC void SIMIX_context_set_parallel_mode(e_xbt_parmap_mode_t mode);
+XBT_PUBLIC unsigned long SIMIX_context_get_rounds(int parallel);
+XBT_PUBLIC double SIMIX_context_get_rounds_duration(int parallel);
 XBT_PUBLIC int SIMIX_is_maestro();
 
 /********************************** Global ************************************/
@@ -166,6 +168,8 @@ XBT_PUBLIC void SIMIX_comm_copy_pointer_callback(simgrid::kernel::activity::Comm
                                                  size_t buff_size);
 XBT_PUBLIC void SIMIX_comm_copy_buffer_callback(simgrid::kernel::activity::CommImpl* comm, void* buff,
                                                 size_t buff_size);
+XBT_PUBLIC void SIMIX_comm_move_buffer_callback(simgrid::kernel::activity::CommImpl* comm, void* buff,
+                                                size_t buff_size);
 #endif
 
 XBT_ATTRIB_DEPRECATED_v325("Please use CommImpl::finish()") XBT_PUBLIC void SIMIX_comm_finish(smx_activity_t synchro);
@@ -14,9 +14,12 @@
 
 #include <boost/optional.hpp>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #if HAVE_FUTEX_H
 #include <linux/futex.h>
@@ -32,6 +35,9 @@ XBT_LOG_EXTERNAL_CATEGORY(xbt_parmap);
 namespace simgrid {
 namespace xbt {
 
+/** @brief Lists the usable CPUs, grouped by NUMA node, in the order in which the parmap workers are bound to them */
+XBT_PUBLIC std::vector<unsigned> parmap_cpus();
+
 /** @addtogroup XBT_parmap
  * @ingroup XBT_misc
  * @brief Parallel map class
@@ -134,9 +140,27 @@ private:
     void worker_wait(unsigned) override;
   };
 
+  /**
+   * @brief Share of the elements owned by a worker in work-stealing mode.
+   *
+   * The bounds [begin, end) of the indexes are packed in a single word, begin in the upper half, so that the owner (taking
+   * elements from the front) and the thieves (taking half of the remaining elements from the back) can both update them
+   * with a compare-and-swap. Shares are padded to the size of a cache line.
+   */
+  class WorkShare {
+  public:
+    std::atomic<uint64_t> bounds{0};
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+    static uint64_t pack(unsigned begin, unsigned end) { return static_cast<uint64_t>(begin) << 32 | end; }
+    static unsigned begin(uint64_t bounds) { return static_cast<unsigned>(bounds >> 32); }
+    static unsigned end(uint64_t bounds) { return static_cast<unsigned>(bounds); }
+  };
+
   static void worker_main(ThreadData* data);
   Synchro* new_synchro(e_xbt_parmap_mode_t mode);
   void work();
+  bool pop_own(unsigned worker, unsigned& index);
+  bool steal(unsigned thief, unsigned& index);
 
   bool destroying;                   /**< is the parmap being destroyed? */
   std::atomic_uint work_round;       /**< index of the current round */
@@ -148,8 +172,14 @@ private:
   std::function<void(T)> fun;           /**< function to run in parallel on each element of data */
   const std::vector<T>* data = nullptr; /**< parameters to pass to fun in parallel */
   std::atomic_uint index;               /**< index of the next element of data to pick */
+
+  bool work_stealing = false;             /**< whether each worker picks in its own share of data */
+  std::unique_ptr<WorkShare[]> shares;    /**< shares of data, per worker (work-stealing mode only) */
+  static thread_local unsigned worker_id; /**< id of the worker running on the current thread (0 for the controller) */
 };
 
+template <typename T> thread_local unsigned Parmap<T>::worker_id = 0;
+
 /**
  * @brief Creates a parallel map object
  * @param num_workers number of worker threads to create
@@ -165,10 +195,15 @@ template <typename T> Parmap<T>::Parmap(unsigned num_workers, e_xbt_parmap_mode_
   this->workers.resize(num_workers);
   this->num_workers = num_workers;
   this->synchro     = new_synchro(mode);
+  if (this->work_stealing)
+    this->shares.reset(new WorkShare[num_workers]);
 
   /* Create the pool of worker threads (the caller of apply() will be worker[0]) */
   this->workers[0] = nullptr;
-  XBT_ATTRIB_UNUSED unsigned int core_bind = 0;
+#if HAVE_PTHREAD_SETAFFINITY
+  /* Neighbor workers are bound to cores of the same NUMA node, which are also the first victims of work stealing */
+  std::vector<unsigned> cpus = parmap_cpus();
+#endif
 
   for (unsigned i = 1; i < num_workers; i++) {
     this->workers[i] = new std::thread(worker_main, new ThreadData(*this, i));
@@ -184,12 +219,8 @@ template <typename T> Parmap<T>::Parmap(unsigned num_workers, e_xbt_parmap_mode_
 #endif
     pthread_t pthread = this->workers[i]->native_handle();
     CPU_ZERO(&cpuset);
-    CPU_SET(core_bind, &cpuset);
+    CPU_SET(cpus[(i - 1) % cpus.size()], &cpuset);
     pthread_setaffinity_np(pthread, size, &cpuset);
-    if (core_bind != std::thread::hardware_concurrency() - 1)
-      core_bind++;
-    else
-      core_bind = 0;
 #endif
   }
 }
@@ -220,6 +251,13 @@ template <typename T> void Parmap<T>::apply(std::function<void(T)>&& fun, const
   this->fun   = std::move(fun);
   this->data  = &data;
   this->index = 0;
+  if (this->work_stealing) {
+    /* Seed each worker with a contiguous chunk of the elements */
+    uint64_t length = data.size();
+    for (unsigned i = 0; i < num_workers; i++)
+      shares[i].bounds.store(WorkShare::pack(length * i / num_workers, length * (i + 1) / num_workers),
+                             std::memory_order_relaxed);
+  }
   this->synchro->master_signal(); // maestro runs futex_wake to wake all the minions (the working threads)
   this->work();                   // maestro works with its minions
   this->synchro->master_wait();   // When there is no more work to do, then maestro waits for the last minion to stop
@@ -235,6 +273,13 @@ template <typename T> void Parmap<T>::apply(std::function<void(T)>&& fun, const
  */
 template <typename T> boost::optional<T> Parmap<T>::next()
 {
+  if (this->work_stealing) {
+    unsigned index;
+    if (pop_own(worker_id, index) || steal(worker_id, index))
+      return (*this->data)[index];
+    else
+      return boost::none;
+  }
   unsigned index = this->index.fetch_add(1, std::memory_order_relaxed);
   if (index < this->data->size())
     return (*this->data)[index];
@@ -247,6 +292,12 @@ template <typename T> boost::optional<T> Parmap<T>::next()
  */
 template <typename T> void Parmap<T>::work()
 {
+  if (this->work_stealing) {
+    unsigned index;
+    while (pop_own(worker_id, index) || steal(worker_id, index))
+      this->fun((*this->data)[index]);
+    return;
+  }
   unsigned length = this->data->size();
   unsigned index  = this->index.fetch_add(1, std::memory_order_relaxed);
   while (index < length) {
@@ -255,12 +306,61 @@ template <typename T> void Parmap<T>::work()
   }
 }
 
+/**
+ * @brief Takes the first element of the share of a worker (work-stealing mode).
+ * @return false if the share is empty
+ */
+template <typename T> bool Parmap<T>::pop_own(unsigned worker, unsigned& index)
+{
+  std::atomic<uint64_t>& bounds = shares[worker].bounds;
+  uint64_t current              = bounds.load(std::memory_order_relaxed);
+  while (WorkShare::begin(current) < WorkShare::end(current)) {
+    if (bounds.compare_exchange_weak(current, current + (uint64_t(1) << 32), std::memory_order_acq_rel)) {
+      index = WorkShare::begin(current);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Steals the last half of the share of another worker, keeps its first element and makes the rest its own share.
+ *
+ * The victims are visited from the closest worker onwards. This is only called when the share of the thief is empty, so
+ * nobody else modifies it.
+ *
+ * @return false if all the shares were found empty
+ */
+template <typename T> bool Parmap<T>::steal(unsigned thief, unsigned& index)
+{
+  for (unsigned i = 1; i < num_workers; i++) {
+    std::atomic<uint64_t>& bounds = shares[(thief + i) % num_workers].bounds;
+    uint64_t current              = bounds.load(std::memory_order_relaxed);
+    while (WorkShare::begin(current) < WorkShare::end(current)) {
+      unsigned begin = WorkShare::begin(current);
+      unsigned end   = WorkShare::end(current);
+      unsigned split = end - (end - begin + 1) / 2;
+      if (bounds.compare_exchange_weak(current, WorkShare::pack(begin, split), std::memory_order_acq_rel)) {
+        XBT_CDEBUG(xbt_parmap, "Worker %u stole %u elements", thief, end - split);
+        shares[thief].bounds.store(WorkShare::pack(split + 1, end), std::memory_order_release);
+        index = split;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 /**
  * Get a synchronization object for given mode.
  * @param mode the synchronization mode
  */
 template <typename T> typename Parmap<T>::Synchro* Parmap<T>::new_synchro(e_xbt_parmap_mode_t mode)
 {
+  if (mode == XBT_PARMAP_WORK_STEALING) {
+    work_stealing = true;
+    mode          = XBT_PARMAP_DEFAULT;
+  }
   if (mode == XBT_PARMAP_DEFAULT) {
 #if HAVE_FUTEX_H
     mode = XBT_PARMAP_FUTEX;
@@ -296,6 +396,7 @@ template <typename T> void Parmap<T>::worker_main(ThreadData* data)
   unsigned round        = 0;
   kernel::context::Context* context = simix_global->context_factory->create_context(std::function<void()>(), nullptr);
   kernel::context::Context::set_current(context);
+  worker_id = data->worker_id;
 
   XBT_CDEBUG(xbt_parmap, "New worker thread created");
 
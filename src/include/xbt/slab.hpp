@@ -0,0 +1,100 @@
+/* Slab allocators of the simulation objects                                */
+
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef XBT_SLAB_HPP
+#define XBT_SLAB_HPP
+
+#include <xbt/base.h>
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <vector>
+
+namespace simgrid {
+namespace xbt {
+
+/** @brief Allocator of fixed-size memory blocks, carved out of large slabs and recycled through free lists
+ *
+ * Each thread keeps a cache of free blocks, so that allocating and releasing a block is only a pointer swap in most
+ * cases. The caches are refilled from (or flushed to) the list shared by all threads by batches, under a mutex. The
+ * slabs are never given back to the system: the blocks are reused by the next objects of the same type.
+ */
+class XBT_PUBLIC SlabAllocator {
+public:
+  SlabAllocator(const char* name, size_t object_size);
+  SlabAllocator(const SlabAllocator&) = delete;
+  SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+  size_t get_object_size() const { return object_size_; }
+  void* allocate();
+  void deallocate(void* block);
+
+  /** Logs the statistics of all the allocators (in the xbt_slab category, at verbose level) */
+  static void report();
+
+private:
+  struct Block {
+    Block* next;
+  };
+  struct Cache {
+    Block* head               = nullptr;
+    size_t count              = 0;
+    unsigned long allocations = 0;
+  };
+  class ThreadCaches;
+
+  Cache* get_cache();
+  void refill(Cache& cache);
+  void flush(Cache& cache, size_t keep);
+
+  const char* name_;
+  size_t object_size_;
+  size_t block_size_;
+  size_t blocks_per_slab_;
+  unsigned id_;
+
+  std::mutex mutex_; // protects everything below
+  Block* free_list_ = nullptr;
+  size_t free_count_ = 0;
+  std::vector<void*> slabs_;
+  unsigned long allocations_ = 0; // made by the threads that are gone, or outside of any cache
+};
+
+/** @brief Gives to a class an allocator of its own, for the objects that are created and destroyed at a high rate
+ *
+ * Use it as a base class: `class Foo : public Pooled<Foo>`. The objects of the subclasses of Foo, if any, are not
+ * pooled since they do not fit in the blocks.
+ */
+template <class T> class Pooled {
+public:
+  static void* operator new(size_t size)
+  {
+    return size == get_allocator().get_object_size() ? get_allocator().allocate() : ::operator new(size);
+  }
+  static void operator delete(void* ptr, size_t size)
+  {
+    if (size == get_allocator().get_object_size())
+      get_allocator().deallocate(ptr);
+    else
+      ::operator delete(ptr);
+  }
+
+private:
+  static SlabAllocator& get_allocator()
+  {
+    // Never destroyed: some objects may be released after the destruction of the static objects
+    static SlabAllocator* allocator = new SlabAllocator(typeid(T).name(), sizeof(T));
+    return *allocator;
+  }
+};
+
+} // namespace xbt
+} // namespace simgrid
+
+#endif
@@ -5,6 +5,8 @@
 
 #include <simgrid/s4u/NetZone.hpp>
 
+#include "src/kernel/routing/RouteCache.hpp"
+
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -26,6 +28,7 @@ public:
   EngineImpl& operator=(const EngineImpl&) = delete;
   virtual ~EngineImpl();
   routing::NetZoneImpl* netzone_root_ = nullptr;
+  routing::RouteCache route_cache_;
 };
 
 } // namespace kernel
@@ -11,6 +11,7 @@
 
 #include <xbt/base.h>
 #include "simgrid/forward.h"
+#include "src/include/xbt/slab.hpp"
 
 #include <atomic>
 #include <simgrid/kernel/resource/Action.hpp>
@@ -46,7 +47,8 @@ public:
   static xbt::signal<void(ActivityImpl const&)> on_resumed;
 };
 
-template <class AnyActivityImpl> class ActivityImpl_T : public ActivityImpl {
+template <class AnyActivityImpl>
+class ActivityImpl_T : public ActivityImpl, public xbt::Pooled<AnyActivityImpl> {
 private:
   std::string name_             = "";
   std::string tracing_category_ = "";
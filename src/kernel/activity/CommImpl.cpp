@@ -85,8 +85,9 @@ XBT_PRIVATE smx_activity_t simcall_HANDLER_comm_isend(
   other_comm->src_data_      = data;
   (*other_comm).set_src_buff(src_buff, src_buff_size).set_size(task_size).set_rate(rate);
 
-  other_comm->match_fun     = match_fun;
-  other_comm->copy_data_fun = copy_data_fun;
+  other_comm->match_fun = match_fun;
+  if (copy_data_fun) // Don't forget the one of the receiver if it came first
+    other_comm->copy_data_fun = copy_data_fun;
 
   if (MC_is_active() || MC_record_replay_is_active())
     other_comm->state_ = SIMIX_RUNNING;
@@ -173,8 +174,9 @@ XBT_PRIVATE smx_activity_t simcall_HANDLER_comm_irecv(
   if (rate > -1.0 && (other_comm->get_rate() < 0.0 || rate < other_comm->get_rate()))
     other_comm->set_rate(rate);
 
-  other_comm->match_fun     = match_fun;
-  other_comm->copy_data_fun = copy_data_fun;
+  other_comm->match_fun = match_fun;
+  if (copy_data_fun) // Don't forget the one of the sender if it came first (eg, to move the data)
+    other_comm->copy_data_fun = copy_data_fun;
 
   if (MC_is_active() || MC_record_replay_is_active()) {
     other_comm->state_ = SIMIX_RUNNING;
@@ -279,7 +281,7 @@ void simcall_HANDLER_comm_testany(smx_simcall_t simcall, simgrid::kernel::activi
   SIMIX_simcall_answer(simcall);
 }
 
-static void SIMIX_waitany_remove_simcall_from_actions(smx_simcall_t simcall)
+void SIMIX_waitany_remove_simcall_from_actions(smx_simcall_t simcall)
 {
   simgrid::kernel::activity::CommImpl** comms = simcall_comm_waitany__get__comms(simcall);
   size_t count                                = simcall_comm_waitany__get__count(simcall);
@@ -358,6 +360,15 @@ void SIMIX_comm_copy_pointer_callback(simgrid::kernel::activity::CommImpl* comm,
   *(void**)(comm->dst_buff_) = buff;
 }
 
+/** Hands the sent buffer itself to the receiver, whatever its size: the receiver gets its address, and its size */
+void SIMIX_comm_move_buffer_callback(simgrid::kernel::activity::CommImpl* comm, void* buff, size_t /*buff_size*/)
+{
+  *(void**)(comm->dst_buff_) = buff;
+  if (comm->dst_buff_size_)
+    *comm->dst_buff_size_ = comm->src_buff_size_;
+  comm->src_buff_ = nullptr; // Owned by the receiver now: not to be cleaned if the comm fails afterward
+}
+
 namespace simgrid {
 namespace kernel {
 namespace activity {
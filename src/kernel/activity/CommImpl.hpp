@@ -72,9 +72,16 @@ expectations of the other side, too. See  */
 
   void* src_data_ = nullptr; /* User data associated to the communication */
   void* dst_data_ = nullptr;
+
+  /* Position in the index of an indexed mailbox (see MailboxImpl::set_match_key) */
+  uint64_t mbox_seq_  = 0;
+  uint64_t match_key_ = 0;
+  bool keyed_         = false;
 };
 } // namespace activity
 } // namespace kernel
 } // namespace simgrid
 
+XBT_PRIVATE void SIMIX_waitany_remove_simcall_from_actions(smx_simcall_t simcall);
+
 #endif
@@ -6,6 +6,7 @@
 #include "src/kernel/activity/MailboxImpl.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 
+#include <algorithm>
 #include <unordered_map>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_mailbox, simix, "Mailbox implementation");
@@ -59,12 +60,75 @@ void MailboxImpl::set_receiver(s4u::ActorPtr actor)
   else
     this->permanent_receiver_ = nullptr;
 }
+/** @brief Indexes the communications of that mailbox by the key that the given function extracts from their user data
+ *
+ * Looking for a communication carrying a key then only considers the queued communications of the same key and the
+ * ones without key, in their order of arrival. Pass nullptr to come back to the plain linear search.
+ */
+void MailboxImpl::set_match_key(match_key_fun_t match_key)
+{
+  comm_queue_.erase(std::remove(comm_queue_.begin(), comm_queue_.end(), nullptr), comm_queue_.end());
+  holes_     = 0;
+  front_seq_ = 0;
+  index_     = {};
+  match_key_ = match_key;
+  if (match_key_ == nullptr)
+    return;
+  for (size_t i = 0; i < comm_queue_.size(); i++) {
+    CommImpl* comm  = comm_queue_[i].get();
+    void* data      = comm->type_ == CommImpl::Type::SEND ? comm->src_data_ : comm->dst_data_;
+    comm->mbox_seq_ = i;
+    comm->keyed_    = data != nullptr && match_key_(data, &comm->match_key_);
+    index(comm);
+  }
+}
+
+void MailboxImpl::index(CommImpl* comm)
+{
+  KeyIndex& index = index_[comm->type_ == CommImpl::Type::SEND ? 0 : 1];
+  if (comm->keyed_)
+    index.keyed[comm->match_key_].push_back(comm);
+  else
+    index.unkeyed.push_back(comm);
+}
+
+/** @brief Removes a communication from the index and leaves a hole at its place in the queue */
+void MailboxImpl::unlink(CommImpl* comm)
+{
+  KeyIndex& index = index_[comm->type_ == CommImpl::Type::SEND ? 0 : 1];
+  auto bucket     = comm->keyed_ ? index.keyed.find(comm->match_key_) : index.keyed.end();
+  std::deque<CommImpl*>& list = bucket != index.keyed.end() ? bucket->second : index.unkeyed;
+  auto pos                    = std::find(list.begin(), list.end(), comm);
+  xbt_assert(pos != list.end(), "Comm %p not found in the index of mailbox %s", comm, this->get_cname());
+  list.erase(pos);
+  if (bucket != index.keyed.end() && list.empty())
+    index.keyed.erase(bucket);
+
+  holes_++;
+  comm_queue_[comm->mbox_seq_ - front_seq_] = nullptr; // may destroy the comm
+  while (not comm_queue_.empty() && comm_queue_.front() == nullptr) {
+    comm_queue_.pop_front();
+    front_seq_++;
+    holes_--;
+  }
+  if (holes_ > 64 && 2 * holes_ > comm_queue_.size()) {
+    comm_queue_.erase(std::remove(comm_queue_.begin(), comm_queue_.end(), nullptr), comm_queue_.end());
+    holes_ = 0;
+    for (size_t i = 0; i < comm_queue_.size(); i++)
+      comm_queue_[i]->mbox_seq_ = front_seq_ + i;
+  }
+}
+
 /** @brief Pushes a communication activity into a mailbox
  *  @param comm What to add
  */
 void MailboxImpl::push(CommImplPtr comm)
 {
   comm->mbox = this;
+  if (match_key_ != nullptr) {
+    comm->mbox_seq_ = front_seq_ + comm_queue_.size();
+    index(comm.get());
+  }
   this->comm_queue_.push_back(std::move(comm));
 }
 
@@ -76,6 +140,10 @@ void MailboxImpl::remove(const CommImplPtr& comm)
   xbt_assert(comm->mbox == this, "Comm %p is in mailbox %s, not mailbox %s", comm.get(),
              (comm->mbox ? comm->mbox->get_cname() : "(null)"), this->get_cname());
   comm->mbox = nullptr;
+  if (match_key_ != nullptr) {
+    unlink(comm.get());
+    return;
+  }
   for (auto it = this->comm_queue_.begin(); it != this->comm_queue_.end(); it++)
     if (*it == comm) {
       this->comm_queue_.erase(it);
@@ -112,6 +180,20 @@ CommImplPtr MailboxImpl::iprobe(int type, int (*match_fun)(void*, void*, CommImp
   return other_comm;
 }
 
+/** @brief Whether a queued communication and the one we are looking for accept each other */
+static bool comm_matches(CommImpl* comm, CommImpl::Type type, int (*match_fun)(void*, void*, CommImpl*),
+                         void* this_user_data, CommImpl* my_synchro)
+{
+  void* other_user_data = nullptr;
+  if (comm->type_ == CommImpl::Type::SEND) {
+    other_user_data = comm->src_data_;
+  } else if (comm->type_ == CommImpl::Type::RECEIVE) {
+    other_user_data = comm->dst_data_;
+  }
+  return comm->type_ == type && (match_fun == nullptr || match_fun(this_user_data, other_user_data, comm)) &&
+         (not comm->match_fun || comm->match_fun(other_user_data, this_user_data, my_synchro));
+}
+
 /**
  *  @brief Checks if there is a communication activity queued in comm_queue_ matching our needs
  *  @param type The type of communication we are looking for (comm_send, comm_recv)
@@ -125,26 +207,31 @@ CommImplPtr MailboxImpl::find_matching_comm(CommImpl::Type type, int (*match_fun
                                             void* this_user_data, const CommImplPtr& my_synchro, bool done,
                                             bool remove_matching)
 {
-  void* other_user_data = nullptr;
-  auto& comm_queue      = done ? done_comm_queue_ : comm_queue_;
+  bool indexed = match_key_ != nullptr && not done;
+  if (match_key_ != nullptr) {
+    // Also remember our key, in case we get pushed into the mailbox afterward
+    my_synchro->keyed_ = this_user_data != nullptr && match_key_(this_user_data, &my_synchro->match_key_);
+    if (indexed && my_synchro->keyed_)
+      return find_indexed_comm(type, match_fun, this_user_data, my_synchro, remove_matching);
+  }
+
+  auto& comm_queue = done ? done_comm_queue_ : comm_queue_;
 
   for (auto it = comm_queue.begin(); it != comm_queue.end(); it++) {
     CommImplPtr& comm = *it;
+    if (comm == nullptr) // hole left in an indexed mailbox
+      continue;
 
-    if (comm->type_ == CommImpl::Type::SEND) {
-      other_user_data = comm->src_data_;
-    } else if (comm->type_ == CommImpl::Type::RECEIVE) {
-      other_user_data = comm->dst_data_;
-    }
-    if (comm->type_ == type && (match_fun == nullptr || match_fun(this_user_data, other_user_data, comm.get())) &&
-        (not comm->match_fun || comm->match_fun(other_user_data, this_user_data, my_synchro.get()))) {
+    if (comm_matches(comm.get(), type, match_fun, this_user_data, my_synchro.get())) {
       XBT_DEBUG("Found a matching communication synchro %p", comm.get());
 #if SIMGRID_HAVE_MC
       comm->mbox_cpy = comm->mbox;
 #endif
       comm->mbox = nullptr;
       CommImplPtr comm_cpy = comm;
-      if (remove_matching)
+      if (remove_matching && indexed)
+        unlink(comm_cpy.get());
+      else if (remove_matching)
         comm_queue.erase(it);
       return comm_cpy;
     }
@@ -155,6 +242,41 @@ CommImplPtr MailboxImpl::find_matching_comm(CommImpl::Type type, int (*match_fun
   XBT_DEBUG("No matching communication synchro found");
   return nullptr;
 }
+
+/** @brief Same as find_matching_comm(), but only considers the comms of our key and the ones without key */
+CommImplPtr MailboxImpl::find_indexed_comm(CommImpl::Type type, int (*match_fun)(void*, void*, CommImpl*),
+                                           void* this_user_data, const CommImplPtr& my_synchro, bool remove_matching)
+{
+  static const std::deque<CommImpl*> no_comm;
+  KeyIndex& index = index_[type == CommImpl::Type::SEND ? 0 : 1];
+  auto bucket     = index.keyed.find(my_synchro->match_key_);
+  const std::deque<CommImpl*>& keyed = bucket != index.keyed.end() ? bucket->second : no_comm;
+
+  // Merge both lists, to consider the candidates in their order of arrival
+  auto k = keyed.begin();
+  auto u = index.unkeyed.begin();
+  while (k != keyed.end() || u != index.unkeyed.end()) {
+    CommImpl* comm;
+    if (u == index.unkeyed.end() || (k != keyed.end() && (*k)->mbox_seq_ < (*u)->mbox_seq_))
+      comm = *k++;
+    else
+      comm = *u++;
+
+    if (comm_matches(comm, type, match_fun, this_user_data, my_synchro.get())) {
+      XBT_DEBUG("Found a matching communication synchro %p in the index", comm);
+#if SIMGRID_HAVE_MC
+      comm->mbox_cpy = comm->mbox;
+#endif
+      comm->mbox = nullptr;
+      CommImplPtr comm_cpy(comm);
+      if (remove_matching)
+        unlink(comm);
+      return comm_cpy;
+    }
+  }
+  XBT_DEBUG("No matching communication synchro found in the index");
+  return nullptr;
+}
 } // namespace activity
 } // namespace kernel
 } // namespace simgrid
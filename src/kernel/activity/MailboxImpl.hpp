@@ -9,6 +9,10 @@
 #include <boost/circular_buffer.hpp>
 #include <xbt/string.hpp>
 
+#include <array>
+#include <deque>
+#include <unordered_map>
+
 #include "simgrid/s4u/Mailbox.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 #include "src/kernel/actor/ActorImpl.hpp"
@@ -32,11 +36,19 @@ class MailboxImpl {
   }
 
 public:
+  /** @brief Extracts the match key of the user data of a communication.
+   *
+   * Returns false if that data may match communications of any key (wildcards). Two communications carrying keys can
+   * only match if their keys are equal.
+   */
+  using match_key_fun_t = bool (*)(void* data, uint64_t* key);
+
   const xbt::string& get_name() const { return name_; }
   const char* get_cname() const { return name_.c_str(); }
   static MailboxImpl* by_name_or_null(const std::string& name);
   static MailboxImpl* by_name_or_create(const std::string& name);
   void set_receiver(s4u::ActorPtr actor);
+  void set_match_key(match_key_fun_t match_key);
   void push(CommImplPtr comm);
   void remove(const CommImplPtr& comm);
   CommImplPtr iprobe(int type, int (*match_fun)(void*, void*, CommImpl*), void* data);
@@ -44,9 +56,27 @@ public:
                                  const CommImplPtr& my_synchro, bool done, bool remove_matching);
 
 private:
+  /* Queued comms of a given type, indexed by match key. Each list is in the order of the comm_queue_ */
+  struct KeyIndex {
+    std::unordered_map<uint64_t, std::deque<CommImpl*>> keyed;
+    std::deque<CommImpl*> unkeyed;
+  };
+
+  void index(CommImpl* comm);
+  void unlink(CommImpl* comm);
+  CommImplPtr find_indexed_comm(CommImpl::Type type, int (*match_fun)(void*, void*, CommImpl*), void* this_user_data,
+                                const CommImplPtr& my_synchro, bool remove_matching);
+
   s4u::Mailbox piface_;
   xbt::string name_;
 
+  match_key_fun_t match_key_ = nullptr;
+  std::array<KeyIndex, 2> index_; // For the SEND and RECEIVE comms
+  /* In indexed mode, the comms leaving the middle of comm_queue_ leave a nullptr behind them. The front of the queue is
+   * never a nullptr, and the queue gets compacted when it is mostly made of holes. */
+  uint64_t front_seq_ = 0; // Sequence number of comm_queue_.front()
+  size_t holes_       = 0;
+
 public:
   actor::ActorImplPtr permanent_receiver_; // actor to which the mailbox is attached
   boost::circular_buffer_space_optimized<CommImplPtr> comm_queue_;
@@ -12,6 +12,7 @@
 #include "src/kernel/activity/IoImpl.hpp"
 #include "src/kernel/activity/SleepImpl.hpp"
 #include "src/kernel/activity/SynchroRaw.hpp"
+#include "src/kernel/context/ContextStackless.hpp"
 #include "src/mc/mc_replay.hpp"
 #include "src/mc/remote/Client.hpp"
 #include "src/simix/smx_private.hpp"
@@ -216,6 +217,13 @@ void ActorImpl::exit()
     }
 
     waiting_synchro = nullptr;
+  } else if (simcall.call == SIMCALL_COMM_WAITANY) {
+    /* A waitany has no waiting synchro: detach it from its communications and from its timeout */
+    SIMIX_waitany_remove_simcall_from_actions(&simcall);
+    if (simcall.timer) {
+      simcall.timer->remove();
+      simcall.timer = nullptr;
+    }
   }
 }
 
@@ -253,8 +261,8 @@ void ActorImpl::set_kill_time(double kill_time)
     return;
   XBT_DEBUG("Set kill time %f for actor %s@%s", kill_time, get_cname(), host_->get_cname());
   kill_timer = simix::Timer::set(kill_time, [this] {
-    this->exit();
     kill_timer = nullptr;
+    simix_global->maestro_process->kill(this); // Also wakes it up if it was blocked on a communication
   });
 }
 
@@ -267,11 +275,19 @@ void ActorImpl::yield()
 {
   XBT_DEBUG("Yield actor '%s'", get_cname());
 
-  /* Go into sleep and return control to maestro */
-  context_->suspend();
+  if (context_->is_stackless()) {
+    /* Handle the simcall right away, as maestro does. If it blocks, the actor is expected to return from its code */
+    SIMIX_simcall_handle(&simcall, 0);
+    xbt_assert(simcall.call == SIMCALL_NONE || static_cast<context::StacklessContext*>(context_.get())->is_awaiting(),
+               "Stackless actor '%s' issued the blocking simcall %s without awaiting it", get_cname(),
+               SIMIX_simcall_name(simcall.call));
+  } else {
+    /* Go into sleep and return control to maestro */
+    context_->suspend();
 
-  /* Ok, maestro returned control to us */
-  XBT_DEBUG("Control returned to me: '%s'", get_cname());
+    /* Ok, maestro returned control to us */
+    XBT_DEBUG("Control returned to me: '%s'", get_cname());
+  }
 
   if (context_->iwannadie) {
     XBT_DEBUG("Actor %s@%s is dead", get_cname(), host_->get_cname());
@@ -448,7 +464,7 @@ ActorImplPtr ActorImpl::init(const std::string& name, s4u::Host* host)
   return ActorImplPtr(actor);
 }
 
-ActorImpl* ActorImpl::start(const simix::ActorCode& code)
+ActorImpl* ActorImpl::start(const simix::ActorCode& code, bool stackless)
 {
   xbt_assert(code && host_ != nullptr, "Invalid parameters");
 
@@ -461,7 +477,12 @@ ActorImpl* ActorImpl::start(const simix::ActorCode& code)
 
   this->code = code;
   XBT_VERB("Create context %s", get_cname());
-  context_.reset(simix_global->context_factory->create_context(simix::ActorCode(code), this));
+  if (stackless) {
+    xbt_assert(not MC_is_active(), "Stackless actors cannot be model-checked");
+    context_.reset(new context::StacklessContext(simix::ActorCode(code), this));
+  } else {
+    context_.reset(simix_global->context_factory->create_context(simix::ActorCode(code), this));
+  }
 
   XBT_DEBUG("Start context '%s'", get_cname());
 
@@ -106,7 +106,8 @@ public:
   s4u::Actor* ciface() { return &piface_; }
 
   ActorImplPtr init(const std::string& name, s4u::Host* host);
-  ActorImpl* start(const simix::ActorCode& code);
+  /** Starts the actor; a stackless actor runs its code on maestro's stack (see context::StacklessContext) */
+  ActorImpl* start(const simix::ActorCode& code, bool stackless = false);
 
   static ActorImplPtr create(const std::string& name, const simix::ActorCode& code, void* data, s4u::Host* host,
                              const std::unordered_map<std::string, std::string>* properties, ActorImpl* parent_actor);
@@ -8,6 +8,7 @@
 #include "simgrid/s4u/Host.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 #include "src/kernel/context/Context.hpp"
+#include "src/kernel/context/ContextStackless.hpp"
 #include "src/simix/smx_private.hpp"
 #include "src/surf/surf_interface.hpp"
 
@@ -81,5 +82,11 @@ AttachContext::~AttachContext() = default;
 /** @brief Executes all the processes to run (in parallel if possible). */
 void SIMIX_context_runall()
 {
+  /* The stackless actors run first, on maestro's stack */
+  if (simgrid::kernel::context::StacklessContext::get_count() > 0) {
+    simgrid::kernel::context::StacklessContext::run_all();
+    if (simix_global->actors_to_run.empty())
+      return;
+  }
   simix_global->context_factory->run_all();
 }
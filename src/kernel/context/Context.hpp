@@ -58,6 +58,8 @@ public:
   void operator()() { code_(); }
   bool has_code() const { return static_cast<bool>(code_); }
   actor::ActorImpl* get_actor() { return this->actor_; }
+  /** Whether this context runs a stackless actor, whose simcalls are handled right away (see StacklessContext) */
+  bool is_stackless() const { return stackless_; }
 
   // Scheduling methods
   virtual void stop();
@@ -68,6 +70,9 @@ public:
   static Context* self();
   /** @brief Sets the current context of this thread */
   static void set_current(Context* self);
+
+protected:
+  bool stackless_ = false;
 };
 
 class XBT_PUBLIC AttachContext : public Context {
@@ -0,0 +1,116 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/kernel/context/ContextStackless.hpp"
+#include "simgrid/Exception.hpp"
+#include "src/simix/smx_private.hpp"
+
+XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(simix_context);
+
+namespace simgrid {
+namespace kernel {
+namespace context {
+
+unsigned long StacklessContext::count_ = 0;
+
+StacklessContext::StacklessContext(std::function<void()>&& code, actor::ActorImpl* actor)
+    : Context(std::move(code), actor)
+{
+  stackless_ = true;
+  count_++;
+}
+
+StacklessContext::~StacklessContext()
+{
+  count_--;
+}
+
+void StacklessContext::suspend()
+{
+  xbt_die("Stackless actor '%s' cannot be suspended in the middle of its code", get_actor()->get_cname());
+}
+
+void StacklessContext::stop()
+{
+  Context::stop();
+  /* Unwind the step function, to free its RAII variables */
+  throw ForcefulKillException();
+}
+
+void StacklessContext::await(std::function<void()>&& on_completion)
+{
+  xbt_assert(not awaiting_, "Stackless actor '%s' can only await one thing at once", get_actor()->get_cname());
+  awaiting_      = true;
+  on_completion_ = std::move(on_completion);
+}
+
+StacklessContext* StacklessContext::current()
+{
+  Context* context = self();
+  xbt_assert(context != nullptr && context->is_stackless(), "Only stackless actors can await activities");
+  return static_cast<StacklessContext*>(context);
+}
+
+void StacklessContext::resume()
+{
+  actor::ActorImpl* actor = get_actor();
+  Context* maestro        = self();
+  set_current(this);
+  do {
+    if (iwannadie) { // killed while it was blocked
+      Context::stop();
+      break;
+    }
+    if (awaiting_) {
+      awaiting_ = false;
+      std::function<void()> on_completion = std::move(on_completion_);
+      on_completion_                      = nullptr;
+      /* On failure, the exception is raised by the next simcall of the actor */
+      if (on_completion && actor->exception_ == nullptr)
+        on_completion();
+    }
+    try {
+      (*this)();
+    } catch (ForcefulKillException const&) {
+      XBT_DEBUG("Caught a ForcefulKillException");
+      break;
+    } catch (simgrid::Exception const& e) {
+      XBT_INFO("Actor killed by an uncaught exception %s", simgrid::xbt::demangle(typeid(e).name()).get());
+      set_current(maestro);
+      throw;
+    }
+    if (not awaiting_) { // The step function returned without blocking: the actor is done
+      Context::stop();
+      break;
+    }
+    /* Call the step function again right away if the awaited activity was already complete */
+  } while (actor->simcall.call == SIMCALL_NONE);
+  set_current(maestro);
+}
+
+void StacklessContext::run_all()
+{
+  static std::vector<actor::ActorImpl*> stackless_actors;
+  std::vector<actor::ActorImpl*>& actors_to_run = simix_global->actors_to_run;
+  /* Running these actors may wake up other stackless actors, that must run in the same round */
+  while (true) {
+    stackless_actors.clear();
+    auto last = actors_to_run.begin();
+    for (actor::ActorImpl* actor : actors_to_run) {
+      if (actor->context_->is_stackless())
+        stackless_actors.push_back(actor);
+      else
+        *last++ = actor;
+    }
+    if (stackless_actors.empty())
+      break;
+    actors_to_run.erase(last, actors_to_run.end());
+    for (actor::ActorImpl* actor : stackless_actors)
+      static_cast<StacklessContext*>(actor->context_.get())->resume();
+  }
+}
+} // namespace context
+} // namespace kernel
+} // namespace simgrid
@@ -0,0 +1,61 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_SIMIX_STACKLESS_CONTEXT_HPP
+#define SIMGRID_SIMIX_STACKLESS_CONTEXT_HPP
+
+#include "src/kernel/context/Context.hpp"
+
+#include <functional>
+
+namespace simgrid {
+namespace kernel {
+namespace context {
+
+/** @brief Context of the actors that have no stack of their own
+ *
+ * The code of a stackless actor is a step function, called by maestro on its own stack each time the actor is
+ * scheduled. The simcalls of such an actor are handled right away, as the ones of maestro. When the step function wants
+ * to block until an activity completes, it declares it with await() just before the blocking simcall, and returns: it
+ * is called again once the simcall is answered. The actor terminates when its step function returns without awaiting
+ * anything.
+ *
+ * These contexts coexist with the ones of the context factory in use, which run the other actors.
+ */
+class StacklessContext : public Context {
+public:
+  StacklessContext(std::function<void()>&& code, actor::ActorImpl* actor);
+  StacklessContext(const StacklessContext&) = delete;
+  StacklessContext& operator=(const StacklessContext&) = delete;
+  ~StacklessContext() override;
+
+  void suspend() override;
+  void stop() override;
+
+  /** Calls the step function of the actor, until it blocks or terminates */
+  void resume();
+
+  /** Declares that the next simcall blocks the actor. The callback is run once it is answered, before the next step */
+  void await(std::function<void()>&& on_completion);
+  bool is_awaiting() const { return awaiting_; }
+
+  /** Returns the context of the current actor, that must be stackless */
+  static StacklessContext* current();
+  /** Runs the stackless actors of simix_global->actors_to_run, and removes them from that list */
+  static void run_all();
+  /** Amount of stackless actors alive */
+  static unsigned long get_count() { return count_; }
+
+private:
+  bool awaiting_ = false;
+  std::function<void()> on_completion_;
+
+  static unsigned long count_;
+};
+} // namespace context
+} // namespace kernel
+} // namespace simgrid
+
+#endif
@@ -9,7 +9,9 @@
 #include "src/kernel/actor/ActorImpl.hpp"
 #include "src/kernel/context/context_private.hpp"
 #include "src/simix/smx_private.hpp"
+#include "xbt/config.hpp"
 #include "xbt/parmap.hpp"
+#include "xbt/xbt_os_time.h"
 
 #include "src/kernel/context/ContextSwapped.hpp"
 
@@ -31,19 +33,85 @@
 
 XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(simix_context);
 
+static simgrid::config::Flag<bool> cfg_adaptive_rounds{
+    "contexts/parallel-adaptive",
+    "Whether to choose at each scheduling round between running the actors sequentially or in parallel, depending on "
+    "the measured cost of both modes",
+    false};
+
 namespace simgrid {
 namespace kernel {
 namespace context {
 
+/* Amount of rounds after which the mode that seems the slowest is measured again, in adaptive mode */
+constexpr unsigned ADAPTIVE_PROBE_PERIOD = 64;
+/* Weight of the last measure in the estimations of the adaptive mode */
+constexpr double ADAPTIVE_SMOOTHING = 0.25;
+
 /* rank of the execution thread */
 thread_local uintptr_t SwappedContext::worker_id_;             /* thread-specific storage for the thread id */
 
-SwappedContextFactory::SwappedContextFactory() : ContextFactory(), parallel_(SIMIX_context_is_parallel())
+SwappedContextFactory::SwappedContextFactory()
+    : ContextFactory(), parallel_(SIMIX_context_is_parallel()), parallel_round_(false)
 {
   parmap_ = nullptr; // will be created lazily with the right parameters if needed (ie, in parallel)
   workers_context_.resize(parallel_ ? SIMIX_context_get_nthreads() : 1, nullptr);
 }
 
+SwappedContextFactory::~SwappedContextFactory()
+{
+  if (parallel_)
+    XBT_VERB("Scheduling rounds: %lu sequential ones (%gs), %lu parallel ones (%gs)", rounds_[false],
+             rounds_duration_[false], rounds_[true], rounds_duration_[true]);
+}
+
+/** Decides whether the next scheduling round, with the given amount of actors, should run in parallel */
+bool SwappedContextFactory::choose_parallel_round(unsigned long count)
+{
+  if (count < static_cast<unsigned long>(SIMIX_context_get_parallel_threshold()))
+    return false;
+  if (not cfg_adaptive_rounds)
+    return true;
+
+  // Measure both modes before predicting anything
+  if (sequential_cost_ < 0)
+    return false;
+  if (parallel_overhead_ < 0)
+    return true;
+
+  double sequential_time = sequential_cost_ * count;
+  double parallel_time   = parallel_overhead_ + sequential_time / SIMIX_context_get_nthreads();
+  bool parallel          = parallel_time < sequential_time;
+  // Regularly run the other mode, in case its cost changed since it was last measured
+  if (++rounds_since_probe_ >= ADAPTIVE_PROBE_PERIOD) {
+    rounds_since_probe_ = 0;
+    parallel            = not parallel;
+  }
+  XBT_DEBUG("%lu actors to run: %s round (estimated %gs sequentially, %gs in parallel)", count,
+            parallel ? "parallel" : "sequential", sequential_time, parallel_time);
+  return parallel;
+}
+
+/** Updates the statistics, and the estimations of the adaptive mode, with the duration of the last round */
+void SwappedContextFactory::account_round(bool parallel, unsigned long count, double duration)
+{
+  rounds_[parallel]++;
+  rounds_duration_[parallel] += duration;
+  if (not cfg_adaptive_rounds)
+    return;
+
+  if (not parallel) {
+    double cost = duration / count;
+    sequential_cost_ =
+        sequential_cost_ < 0 ? cost : (1 - ADAPTIVE_SMOOTHING) * sequential_cost_ + ADAPTIVE_SMOOTHING * cost;
+  } else if (sequential_cost_ >= 0) {
+    double overhead    = std::max(0.0, duration - sequential_cost_ * count / SIMIX_context_get_nthreads());
+    parallel_overhead_ = parallel_overhead_ < 0 ? overhead
+                                                : (1 - ADAPTIVE_SMOOTHING) * parallel_overhead_ +
+                                                      ADAPTIVE_SMOOTHING * overhead;
+  }
+}
+
 SwappedContext::SwappedContext(std::function<void()>&& code, smx_actor_t actor, SwappedContextFactory* factory)
     : Context(std::move(code), actor), factory_(factory)
 {
@@ -53,7 +121,10 @@ SwappedContext::SwappedContext(std::function<void()>&& code, smx_actor_t actor,
 
   if (has_code()) {
     xbt_assert((smx_context_stack_size & 0xf) == 0, "smx_context_stack_size should be multiple of 16");
-    if (smx_context_guard_size > 0 && not MC_is_active()) {
+    if (StackPool::is_enabled()) {
+      this->stack_        = factory_->stack_pool_.get();
+      this->pooled_stack_ = true;
+    } else if (smx_context_guard_size > 0 && not MC_is_active()) {
 
 #if !defined(PTH_STACKGROWTH) || (PTH_STACKGROWTH != -1)
       xbt_die(
@@ -119,6 +190,11 @@ SwappedContext::~SwappedContext()
     VALGRIND_STACK_DEREGISTER(valgrind_stack_id_);
 #endif
 
+  if (pooled_stack_) { // the guard pages are kept in place for the next user of this stack
+    factory_->stack_pool_.release(stack_);
+    return;
+  }
+
 #ifndef _WIN32
   if (smx_context_guard_size > 0 && not MC_is_active()) {
     stack_ = stack_ - smx_context_guard_size;
@@ -155,7 +231,13 @@ void SwappedContextFactory::run_all()
    * stuff It is much easier to understand what happens if you see the working threads as bodies that swap their soul
    * for the ones of the simulated processes that must run.
    */
-  if (parallel_) {
+  unsigned long count = simix_global->actors_to_run.size();
+  if (count == 0)
+    return;
+
+  parallel_round_ = parallel_ && choose_parallel_round(count);
+  double start    = xbt_os_time();
+  if (parallel_round_) {
     threads_working_ = 0;
 
     // We lazily create the parmap so that all options are actually processed when doing so.
@@ -176,15 +258,16 @@ void SwappedContextFactory::run_all()
         },
         simix_global->actors_to_run);
   } else { // sequential execution
-    if (simix_global->actors_to_run.empty())
-      return;
-
-    /* maestro is already saved in the first slot of workers_context_ */
+    /* maestro is already saved in the first slot of workers_context_, unless parallel rounds may have overwritten it */
+    if (parallel_)
+      workers_context_[0] = static_cast<SwappedContext*>(Context::self());
     smx_actor_t first_actor = simix_global->actors_to_run.front();
     process_index_          = 1;
     /* execute the first actor; it will chain to the others when using suspend() */
     static_cast<SwappedContext*>(first_actor->context_.get())->resume();
   }
+  if (parallel_)
+    account_round(parallel_round_, count, xbt_os_time() - start);
 }
 
 /** Maestro wants to yield back to a given actor, so awake it on the current thread
@@ -195,7 +278,7 @@ void SwappedContextFactory::run_all()
  */
 void SwappedContext::resume()
 {
-  if (factory_->parallel_) {
+  if (factory_->parallel_round_) {
     // Save the thread number (my body) in an os-thread-specific area
     worker_id_ = factory_->threads_working_.fetch_add(1, std::memory_order_relaxed);
     // Save my current soul (either maestro, or one of the minions) in a permanent area
@@ -223,7 +306,7 @@ void SwappedContext::resume()
  */
 void SwappedContext::suspend()
 {
-  if (factory_->parallel_) {
+  if (factory_->parallel_round_) {
     // Get some more work to directly swap into the next executable actor instead of yielding back to the parmap
     boost::optional<smx_actor_t> next_work = factory_->parmap_->next();
     SwappedContext* next_context;
@@ -7,6 +7,8 @@
 #define SIMGRID_SIMIX_SWAPPED_CONTEXT_HPP
 
 #include "src/kernel/context/Context.hpp"
+#include "src/kernel/context/StackPool.hpp"
+#include "xbt/parmap.hpp"
 
 #include <memory>
 #include <vector>
@@ -22,10 +24,26 @@ public:
   SwappedContextFactory();
   SwappedContextFactory(const SwappedContextFactory&) = delete;
   SwappedContextFactory& operator=(const SwappedContextFactory&) = delete;
+  ~SwappedContextFactory();
   void run_all() override;
 
+  /** Number of scheduling rounds run sequentially (parallel=false) or in parallel (parallel=true) */
+  unsigned long get_rounds(bool parallel) const { return rounds_[parallel]; }
+  /** Wall-clock time spent in the scheduling rounds run sequentially or in parallel */
+  double get_rounds_duration(bool parallel) const { return rounds_duration_[parallel]; }
+
 private:
-  bool parallel_;
+  bool parallel_;       // Whether the actors may be run in parallel
+  bool parallel_round_; // Whether the current scheduling round is run in parallel
+
+  bool choose_parallel_round(unsigned long count);
+  void account_round(bool parallel, unsigned long count, double duration);
+
+  unsigned long rounds_[2]    = {0, 0};
+  double rounds_duration_[2]  = {0.0, 0.0};
+  double sequential_cost_     = -1.0; // Estimated time to run one actor sequentially (negative if unknown)
+  double parallel_overhead_   = -1.0; // Estimated time lost in the synchronization of a parallel round (idem)
+  unsigned rounds_since_probe_ = 0;   // Rounds since the mode that seemed the slowest was last measured
 
   unsigned long process_index_ = 0; // Next actor to execute during sequential run_all()
 
@@ -33,6 +51,8 @@ private:
   std::unique_ptr<simgrid::xbt::Parmap<smx_actor_t>> parmap_;
   std::vector<SwappedContext*> workers_context_; /* space to save the worker's context in each thread */
   std::atomic<uintptr_t> threads_working_{0};    /* number of threads that have started their work */
+
+  StackPool stack_pool_; /* recycled stacks of the actors */
 };
 
 class SwappedContext : public Context {
@@ -61,6 +81,7 @@ public:
 
 private:
   unsigned char* stack_ = nullptr;       /* the thread stack */
+  bool pooled_stack_    = false;         /* whether the stack comes from the factory's stack pool */
   SwappedContextFactory* const factory_; // for sequential and parallel run_all()
 
 #if HAVE_VALGRIND_H
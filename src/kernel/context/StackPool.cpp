@@ -0,0 +1,127 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/kernel/context/StackPool.hpp"
+#include "simgrid/modelchecker.h"
+#include "simgrid/simix.h"
+#include "src/internal_config.h"
+#include "xbt/config.hpp"
+#include "xbt/log.h"
+#include "xbt/sysdep.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(simix_context);
+
+static simgrid::config::Flag<bool> cfg_stack_pool{"contexts/stack-pool",
+                                                  "Whether to recycle the stacks of the actors (not with threads)", true};
+static simgrid::config::Flag<bool> cfg_stack_huge_pages{
+    "contexts/stack-huge-pages", "Whether to back the stacks of the actors with transparent huge pages, when possible",
+    false};
+
+namespace simgrid {
+namespace kernel {
+namespace context {
+
+/* Virtual size of the regions reserved for the stacks */
+constexpr size_t REGION_SIZE = 1UL << 30;
+
+bool StackPool::is_enabled()
+{
+#if defined(_WIN32) || !defined(PTH_STACKGROWTH) || (PTH_STACKGROWTH != -1)
+  return false; // the guard pages are put below the stacks
+#else
+  return cfg_stack_pool && not MC_is_active();
+#endif
+}
+
+StackPool::~StackPool()
+{
+  if (regions_.empty())
+    return;
+  XBT_VERB("Stack pool: %lu stacks created, %lu reused, at most %lu at the same time (%zu regions of %zu bytes)",
+           created_, reused_, peak_, regions_.size(), regions_.front().second);
+#ifndef _WIN32
+  for (auto const& region : regions_)
+    munmap(region.first, region.second);
+#endif
+}
+
+void StackPool::reserve_region()
+{
+#ifndef _WIN32
+  if (regions_.empty()) {
+    guard_size_       = smx_context_guard_size;
+    size_t stack_size = (smx_context_stack_size + xbt_pagesize - 1) / xbt_pagesize * xbt_pagesize;
+    slot_size_        = guard_size_ + stack_size;
+    slots_per_region_ = std::max<size_t>(1, REGION_SIZE / slot_size_);
+  }
+  xbt_assert(guard_size_ == smx_context_guard_size && slot_size_ >= guard_size_ + smx_context_stack_size,
+             "The size of the stacks cannot change once actors were created");
+
+  size_t size = slots_per_region_ * slot_size_;
+  int flags   = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE; // The pages are only committed when the stacks touch them
+#endif
+  void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (region == MAP_FAILED)
+    xbt_die("Failed to reserve %zu bytes for the stacks of the actors: %s", size, strerror(errno));
+#ifdef MADV_HUGEPAGE
+  if (cfg_stack_huge_pages && madvise(region, size, MADV_HUGEPAGE) != 0)
+    XBT_WARN("Failed to use transparent huge pages for the stacks: %s", strerror(errno));
+#endif
+  XBT_DEBUG("New region of %zu stacks at %p", slots_per_region_, region);
+  regions_.emplace_back(static_cast<unsigned char*>(region), size);
+  next_slot_ = static_cast<unsigned char*>(region);
+  end_       = next_slot_ + size;
+#endif
+}
+
+unsigned char* StackPool::get()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  unsigned char* stack;
+  if (not free_stacks_.empty()) {
+    stack = free_stacks_.back();
+    free_stacks_.pop_back();
+    reused_++;
+  } else {
+    if (next_slot_ == end_)
+      reserve_region();
+#ifndef _WIN32
+    if (guard_size_ > 0 && mprotect(next_slot_, guard_size_, PROT_NONE) == -1)
+      xbt_die("Failed to protect stack: %s.\n"
+              "If you are running a lot of actors, you may be exceeding the amount of mappings allowed per process.\n"
+              "On Linux systems, change this value with sudo sysctl -w vm.max_map_count=newvalue (default value: "
+              "65536)\n"
+              "Please see http://simgrid.gforge.inria.fr/simgrid/latest/doc/html/options.html#options_virt for more "
+              "info.",
+              strerror(errno));
+#endif
+    stack = next_slot_ + guard_size_;
+    next_slot_ += slot_size_;
+    created_++;
+  }
+  in_use_++;
+  peak_ = std::max(peak_, in_use_);
+  return stack;
+}
+
+void StackPool::release(unsigned char* stack)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_stacks_.push_back(stack);
+  in_use_--;
+}
+} // namespace context
+} // namespace kernel
+} // namespace simgrid
@@ -0,0 +1,68 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_KERNEL_CONTEXT_STACKPOOL_HPP
+#define SIMGRID_KERNEL_CONTEXT_STACKPOOL_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace simgrid {
+namespace kernel {
+namespace context {
+
+/** @brief Recycles the stacks of the actors
+ *
+ * The stacks are carved out of large memory regions, that are reserved at once and whose pages are only committed when
+ * the stacks actually use them. Each stack is preceded by its guard pages (--cfg=contexts/guard-size), that are only
+ * protected once: the stacks of the dead actors are kept with their guard pages, and given to the next actors.
+ * The regions may be backed by transparent huge pages (--cfg=contexts/stack-huge-pages).
+ *
+ * Actors may be destroyed from the worker threads in parallel mode, so the pool is protected by a mutex.
+ * The pool is used unless disabled with --cfg=contexts/stack-pool:no, or when model-checking.
+ */
+class StackPool {
+public:
+  StackPool() = default;
+  StackPool(const StackPool&) = delete;
+  StackPool& operator=(const StackPool&) = delete;
+  ~StackPool();
+
+  /** Whether the stacks of the actors should be taken from the pool */
+  static bool is_enabled();
+
+  /** Returns a stack of smx_context_stack_size bytes, preceded by smx_context_guard_size bytes of protected memory */
+  unsigned char* get();
+  /** Gives back a stack obtained with get() */
+  void release(unsigned char* stack);
+
+  unsigned long get_created() const { return created_; }
+  unsigned long get_reused() const { return reused_; }
+  unsigned long get_peak() const { return peak_; }
+
+private:
+  void reserve_region();
+
+  std::mutex mutex_;
+  size_t guard_size_ = 0;
+  size_t slot_size_  = 0; // guard pages and stack
+  size_t slots_per_region_ = 0;
+  std::vector<std::pair<unsigned char*, size_t>> regions_; // address and size of the reserved regions
+  unsigned char* next_slot_ = nullptr;                     // first unused slot of the last region
+  unsigned char* end_       = nullptr;                     // end of the last region
+  std::vector<unsigned char*> free_stacks_;
+
+  unsigned long created_ = 0; // stacks created from fresh slots
+  unsigned long reused_  = 0; // stacks given back and then reused
+  unsigned long in_use_  = 0;
+  unsigned long peak_    = 0; // maximal amount of stacks in use at the same time
+};
+} // namespace context
+} // namespace kernel
+} // namespace simgrid
+
+#endif
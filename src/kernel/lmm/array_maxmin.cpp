@@ -0,0 +1,613 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "simgrid/sg_config.hpp"
+#include "src/include/xbt/parmap.hpp"
+#include "src/kernel/lmm/maxmin.hpp"
+#include "src/surf/surf_interface.hpp"
+
+#include <algorithm>
+
+XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(surf_maxmin);
+
+namespace simgrid {
+namespace kernel {
+namespace lmm {
+
+System* make_new_array_maxmin_system(bool selective_update)
+{
+  return new ArrayMaxMin(selective_update);
+}
+
+ArrayMaxMin::ArrayMaxMin(bool selective_update)
+    : System(selective_update), incremental_(config::get_value<bool>("maxmin/incremental"))
+{
+}
+
+ArrayMaxMin::~ArrayMaxMin() = default;
+
+/* The progressive filling below is a line by line translation of System::lmm_solve(), working on the arrays instead
+ * of the intrusive lists. Every floating point operation is done in the same order than in the original solver so
+ * that both produce exactly the same values: do not reorder anything here without doing the same over there.
+ *
+ * The only list of the original solver that is not trivially mapped is active_element_set, in which elements are
+ * pushed at the front and removed as soon as their variable gets fixed. Here, the active elements of each constraint
+ * are stored in reverse order of the enabled_element_set, and the fixed variables are lazily compacted away.
+ *
+ * With a single thread, the whole system is filled at once, exactly as the original solver does. With several
+ * threads, each connected component is filled on its own. This gives the same values, except in the degenerate case
+ * where two components saturate at exactly the same level while bounded variables are within the precision of that
+ * level: the original solver then fixes them together, each component does it on its own.
+ *
+ * The warm start relies on the levels at which the variables got fixed (min_usage, or the level of their bound) and
+ * at which the constraints got saturated. The amount of the capacity of a constraint c that is used when the filling
+ * reaches the level L is then
+ *   used_c(L) = sum over the variables v of c of weight(c,v) * min(L, level_v) / sharing_weight_v
+ * It is continuous and increasing in L, and the constraint saturates when it reaches its bound. As long as this level
+ * is the same for every constraint, the filling does exactly the same. So the previous solution holds up to the
+ * smallest level at which a constraint now saturates while it did not (or the other way around).
+ */
+
+void ArrayMaxMin::array_solve()
+{
+  if (modified_) {
+    XBT_IN("(sys=%p)", this);
+    if (selective_update_active)
+      array_solve(modified_constraint_set);
+    else
+      array_solve(active_constraint_set);
+    XBT_OUT();
+  }
+}
+
+template <class CnstList> void ArrayMaxMin::array_solve(CnstList& cnst_list)
+{
+  load_arrays(cnst_list);
+  if (incremental_)
+    warm_start();
+  split_components();
+  solve_components();
+  store_arrays();
+
+  modified_ = false;
+  if (selective_update_active)
+    remove_all_modified_set();
+
+  if (XBT_LOG_ISENABLED(surf_maxmin, xbt_log_priority_debug)) {
+    print();
+  }
+
+  check_concurrency();
+}
+
+template <class CnstList> void ArrayMaxMin::load_arrays(CnstList& cnst_list)
+{
+  XBT_DEBUG("Active constraints : %zu", cnst_list.size());
+
+  cnst_.clear();
+  cnst_bound_.clear();
+  cnst_remaining_.clear();
+  cnst_usage_.clear();
+  cnst_fatpipe_.clear();
+  cnst_skipped_.clear();
+  cnst_light_.clear();
+  cnst_active_.clear();
+  cnst_elem_start_.clear();
+  cnst_elem_end_.clear();
+  cnst_elem_var_.clear();
+  cnst_elem_weight_.clear();
+  var_.clear();
+  var_weight_.clear();
+  var_bound_.clear();
+  var_elem_start_.clear();
+  cnst_enabled_start_.clear();
+  enabled_var_.clear();
+  enabled_rank_.clear();
+  enabled_weight_.clear();
+  light_tab_.clear();
+
+  /* Walk the enabled elements of the constraints only once, indexing the variables on the fly and collecting the
+   * constraints that actually need to be saturated (i.e remaining and usage are strictly positive) */
+  for (Constraint& cnst : cnst_list) {
+    int c            = static_cast<int>(cnst_.size());
+    bool fatpipe     = cnst.sharing_policy == s4u::Link::SharingPolicy::FATPIPE;
+    bool skipped     = not double_positive(cnst.bound, cnst.bound * sg_maxmin_precision);
+    double usage     = skipped ? cnst.usage : 0.0;
+    cnst.array_index = c;
+    cnst_.push_back(&cnst);
+    cnst_bound_.push_back(cnst.bound);
+    cnst_remaining_.push_back(cnst.bound);
+    cnst_fatpipe_.push_back(fatpipe);
+    cnst_skipped_.push_back(skipped);
+    cnst_light_.push_back(-1);
+    cnst_elem_start_.push_back(static_cast<int>(cnst_elem_var_.size()));
+    cnst_enabled_start_.push_back(static_cast<int>(enabled_var_.size()));
+
+    for (Element& elem : cnst.enabled_element_set) {
+      Variable* var = elem.variable;
+      xbt_assert(var->sharing_weight > 0);
+      if (var->array_index < 0) {
+        var->array_index = static_cast<int>(var_.size());
+        var_.push_back(var);
+        var_weight_.push_back(var->sharing_weight);
+        var_bound_.push_back(var->bound);
+        var_elem_start_.push_back(static_cast<int>(var->cnsts.size()));
+      }
+      enabled_var_.push_back(var->array_index);
+      enabled_rank_.push_back(static_cast<int>(&elem - var->cnsts.data()));
+      enabled_weight_.push_back(elem.consumption_weight);
+
+      if (skipped || elem.consumption_weight <= 0)
+        continue;
+      if (fatpipe)
+        usage = std::max(usage, elem.consumption_weight / var->sharing_weight);
+      else
+        usage += elem.consumption_weight / var->sharing_weight;
+      cnst_elem_var_.push_back(var->array_index);
+      cnst_elem_weight_.push_back(elem.consumption_weight);
+
+      resource::Action* action = static_cast<resource::Action*>(var->id);
+      if (modified_set_ && not incremental_ && not action->is_within_modified_set())
+        modified_set_->push_back(*action);
+    }
+    cnst_usage_.push_back(usage);
+    cnst_elem_end_.push_back(static_cast<int>(cnst_elem_var_.size()));
+    cnst_active_.push_back(cnst_elem_end_[c] - cnst_elem_start_[c]);
+    if (skipped)
+      continue;
+
+    // Mimic the push_front() into the active_element_set of the original solver
+    std::reverse(cnst_elem_var_.begin() + cnst_elem_start_[c], cnst_elem_var_.end());
+    std::reverse(cnst_elem_weight_.begin() + cnst_elem_start_[c], cnst_elem_weight_.end());
+
+    XBT_DEBUG("Constraint '%d' usage: %f remaining: %f concurrency: %i<=%i<=%i", cnst.id_int, usage, cnst.bound,
+              cnst.concurrency_current, cnst.concurrency_maximum, cnst.get_concurrency_limit());
+
+    if (usage > 0)
+      light_tab_.push_back({cnst.bound / usage, c});
+  }
+
+  /* Build the incidence of each variable, in the order of its elements. For now, var_elem_start_ contains the amount
+   * of elements of each variable. */
+  int offset = 0;
+  for (int& start : var_elem_start_) {
+    int count = start;
+    start     = offset;
+    offset += count;
+  }
+  var_elem_start_.push_back(offset);
+  var_elem_cnst_.assign(offset, -1);
+  var_elem_weight_.assign(offset, 0.0);
+  cnst_enabled_start_.push_back(static_cast<int>(enabled_var_.size()));
+  for (unsigned c = 0; c < cnst_.size(); c++) {
+    for (int e = cnst_enabled_start_[c]; e < cnst_enabled_start_[c + 1]; e++) {
+      int pos               = var_elem_start_[enabled_var_[e]] + enabled_rank_[e];
+      var_elem_cnst_[pos]   = c;
+      var_elem_weight_[pos] = enabled_weight_[e];
+    }
+  }
+  var_value_.assign(var_.size(), 0.0);
+  var_fixed_.assign(var_.size(), false);
+  var_saturated_.assign(var_.size(), false);
+  var_level_.assign(var_.size(), std::numeric_limits<double>::infinity());
+  cnst_level_.assign(cnst_.size(), std::numeric_limits<double>::infinity());
+}
+
+void ArrayMaxMin::warm_start()
+{
+  constexpr double infinity = std::numeric_limits<double>::infinity();
+
+  var_prev_level_.resize(var_.size());
+  var_prev_value_.resize(var_.size());
+  var_modified_.resize(var_.size());
+  for (unsigned v = 0; v < var_.size(); v++) {
+    Variable* var    = var_[v];
+    var_modified_[v] = var->solved_weight != var_weight_[v] || var->solved_bound != var_bound_[v];
+    if (var_modified_[v]) {
+      // Its previous level is meaningless. At least, it will not go further than its bound.
+      var_prev_level_[v] = var_bound_[v] > 0 ? var_bound_[v] * var_weight_[v] : infinity;
+      var_prev_value_[v] = var_bound_[v];
+    } else {
+      var_prev_level_[v] = var->saturation_level;
+      var_prev_value_[v] = var->value;
+    }
+  }
+
+  double first_level = infinity;
+  for (unsigned c = 0; c < cnst_.size(); c++)
+    first_level = std::min(first_level, first_change(c));
+
+  /* The variables fixed below first_level keep their value. If too many of them are affected, a full solve is
+   * cheaper than the warm start */
+  unsigned affected = 0;
+  for (unsigned v = 0; v < var_.size(); v++)
+    if (var_modified_[v] || var_prev_level_[v] > first_level - sg_maxmin_precision)
+      affected++;
+  XBT_DEBUG("Warm start: the system changes at level %g, affecting %u variables out of %zu", first_level, affected,
+            var_.size());
+  if (2 * affected > var_.size()) {
+    for (Variable const* var : var_) {
+      resource::Action* action = static_cast<resource::Action*>(var->id);
+      if (modified_set_ && not action->is_within_modified_set())
+        modified_set_->push_back(*action);
+    }
+    return;
+  }
+
+  for (unsigned v = 0; v < var_.size(); v++) {
+    if (var_modified_[v] || var_prev_level_[v] > first_level - sg_maxmin_precision) {
+      resource::Action* action = static_cast<resource::Action*>(var_[v]->id);
+      if (modified_set_ && not action->is_within_modified_set())
+        modified_set_->push_back(*action);
+    } else {
+      var_fixed_[v] = true;
+      var_value_[v] = var_prev_value_[v];
+      var_level_[v] = var_prev_level_[v];
+    }
+  }
+
+  /* Remove the fixed variables from the constraints, and only saturate what remains */
+  light_tab_.clear();
+  for (unsigned c = 0; c < cnst_.size(); c++) {
+    if (cnst_[c]->saturation_level < first_level - sg_maxmin_precision)
+      cnst_level_[c] = cnst_[c]->saturation_level;
+    if (cnst_skipped_[c])
+      continue;
+    double remaining = cnst_bound_[c];
+    double usage     = 0.0;
+    int end          = cnst_elem_start_[c];
+    for (int e = cnst_elem_start_[c]; e < cnst_elem_end_[c]; e++) {
+      int v = cnst_elem_var_[e];
+      if (var_fixed_[v]) {
+        if (not cnst_fatpipe_[c])
+          double_update(&remaining, cnst_elem_weight_[e] * var_value_[v], cnst_bound_[c] * sg_maxmin_precision);
+        cnst_active_[c]--;
+        continue;
+      }
+      if (cnst_fatpipe_[c])
+        usage = std::max(usage, cnst_elem_weight_[e] / var_weight_[v]);
+      else
+        usage += cnst_elem_weight_[e] / var_weight_[v];
+      cnst_elem_var_[end]    = v;
+      cnst_elem_weight_[end] = cnst_elem_weight_[e];
+      end++;
+    }
+    cnst_elem_end_[c]    = end;
+    cnst_remaining_[c] = remaining;
+    cnst_usage_[c]     = usage;
+    if (usage > 0 && double_positive(remaining, cnst_bound_[c] * sg_maxmin_precision))
+      light_tab_.push_back({remaining / usage, static_cast<int>(c)});
+  }
+}
+
+/* Returns the level from which the constraint does not behave as in the previous solve any more (infinity if it still
+ * does) */
+double ArrayMaxMin::first_change(int c)
+{
+  double level = cnst_[c]->saturation_level;
+  if (cnst_skipped_[c])
+    return level;
+
+  double bound     = cnst_bound_[c];
+  double tolerance = bound * sg_maxmin_precision;
+  if (cnst_fatpipe_[c]) {
+    // Non-shared constraints saturate as soon as one of the remaining variables reaches the bound
+    if (level < std::numeric_limits<double>::infinity()) {
+      double usage = 0.0;
+      for (int e = cnst_enabled_start_[c]; e < cnst_enabled_start_[c + 1]; e++) {
+        int v = enabled_var_[e];
+        if (enabled_weight_[e] > 0 && var_prev_level_[v] >= level)
+          usage = std::max(usage, enabled_weight_[e] / var_weight_[v]);
+      }
+      if (std::fabs(bound - level * usage) <= tolerance)
+        return std::numeric_limits<double>::infinity();
+    }
+    double new_level = std::numeric_limits<double>::infinity();
+    for (int e = cnst_enabled_start_[c]; e < cnst_enabled_start_[c + 1]; e++) {
+      int v = enabled_var_[e];
+      if (enabled_weight_[e] <= 0)
+        continue;
+      double reached = bound / (enabled_weight_[e] / var_weight_[v]);
+      if (reached <= var_prev_level_[v])
+        new_level = std::min(new_level, reached);
+    }
+    return std::min(level, new_level);
+  }
+
+  if (level < std::numeric_limits<double>::infinity()) {
+    double used = 0.0;
+    for (int e = cnst_enabled_start_[c]; e < cnst_enabled_start_[c + 1]; e++) {
+      int v = enabled_var_[e];
+      if (enabled_weight_[e] > 0)
+        used += enabled_weight_[e] * (var_prev_level_[v] < level ? var_prev_value_[v] : level / var_weight_[v]);
+    }
+    if (std::fabs(bound - used) <= tolerance)
+      return std::numeric_limits<double>::infinity(); // Still saturates at the same level
+    if (used < bound)
+      return level; // Now saturates later, or not at all
+  }
+  return std::min(level, shared_saturation_level(c));
+}
+
+/* Returns the level at which the shared constraint saturates, assuming that its variables get fixed at their previous
+ * level */
+double ArrayMaxMin::shared_saturation_level(int c)
+{
+  level_order_.clear();
+  double usage = 0.0;
+  for (int e = cnst_enabled_start_[c]; e < cnst_enabled_start_[c + 1]; e++) {
+    if (enabled_weight_[e] <= 0)
+      continue;
+    level_order_.emplace_back(var_prev_level_[enabled_var_[e]], e);
+    usage += enabled_weight_[e] / var_weight_[enabled_var_[e]];
+  }
+  std::sort(level_order_.begin(), level_order_.end());
+
+  double remaining = cnst_bound_[c];
+  for (auto const& elem : level_order_) {
+    if (not double_positive(usage, sg_maxmin_precision))
+      break;
+    if (remaining / usage <= elem.first)
+      return remaining / usage;
+    int v = enabled_var_[elem.second];
+    remaining -= enabled_weight_[elem.second] * var_prev_value_[v];
+    usage -= enabled_weight_[elem.second] / var_weight_[v];
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+void ArrayMaxMin::split_components()
+{
+  int count = 0;
+  if (sg_maxmin_threads <= 1) {
+    /* Everything goes in the same component */
+    cnst_component_.assign(cnst_.size(), 0);
+    count = 1;
+  } else {
+    /* Union-find on the constraints sharing a variable. Each set is represented by its smallest constraint so that
+     * the components do not depend on the order in which the variables are walked. */
+    std::vector<int>& parent = cnst_component_;
+    parent.resize(cnst_.size());
+    for (unsigned c = 0; c < parent.size(); c++)
+      parent[c] = c;
+    auto find = [&parent](int c) {
+      while (parent[c] != c) {
+        parent[c] = parent[parent[c]];
+        c         = parent[c];
+      }
+      return c;
+    };
+    for (unsigned v = 0; v < var_.size(); v++) {
+      int root = -1;
+      for (int e = var_elem_start_[v]; e < var_elem_start_[v + 1]; e++) {
+        if (var_elem_cnst_[e] < 0)
+          continue;
+        int other = find(var_elem_cnst_[e]);
+        if (root < 0) {
+          root = other;
+        } else if (other < root) {
+          parent[root] = other;
+          root         = other;
+        } else if (other > root) {
+          parent[other] = root;
+        }
+      }
+    }
+    /* Roots are the smallest element of their set, so a single pass in increasing order flattens everything. Then
+     * number the components in the order of their first constraint: cnst_component_ becomes -1 - number. */
+    for (unsigned c = 0; c < parent.size(); c++) {
+      int up = parent[c];
+      if (up == static_cast<int>(c))
+        parent[c] = -1 - count++;
+      else
+        parent[c] = parent[up];
+    }
+    for (int& comp : cnst_component_)
+      comp = -1 - comp;
+  }
+
+  if (components_.size() < static_cast<unsigned>(count))
+    components_.resize(count);
+  for (int k = 0; k < count; k++) {
+    components_[k].light_tab.clear();
+    components_[k].saturated_constraints.clear();
+    components_[k].saturated_variables.clear();
+    components_[k].elements = 0;
+  }
+  schedule_.clear();
+  for (LightConstraint const& light : light_tab_) {
+    Component& comp = components_[cnst_component_[light.cnst]];
+    if (comp.light_tab.empty())
+      schedule_.push_back(&comp);
+    cnst_light_[light.cnst] = static_cast<int>(comp.light_tab.size());
+    comp.light_tab.push_back(light);
+    comp.elements += cnst_elem_end_[light.cnst] - cnst_elem_start_[light.cnst];
+  }
+}
+
+void ArrayMaxMin::solve_components()
+{
+  if (sg_maxmin_threads > 1 && schedule_.size() > 1 &&
+      cnst_elem_var_.size() >= static_cast<size_t>(sg_maxmin_parallel_threshold) && simix_global &&
+      simix_global->context_factory) {
+    /* Start with the largest components so that the small ones fill the gaps at the end */
+    std::stable_sort(schedule_.begin(), schedule_.end(),
+                     [](Component const* a, Component const* b) { return a->elements > b->elements; });
+    XBT_DEBUG("Solving %zu components on %d threads", schedule_.size(), sg_maxmin_threads);
+    if (parmap_threads_ != sg_maxmin_threads) {
+      parmap_.reset(new xbt::Parmap<Component*>(sg_maxmin_threads, XBT_PARMAP_DEFAULT));
+      parmap_threads_ = sg_maxmin_threads;
+    }
+    parmap_->apply([this](Component* comp) { progressive_filling(*comp); }, schedule_);
+  } else {
+    for (Component* comp : schedule_)
+      progressive_filling(*comp);
+  }
+}
+
+void ArrayMaxMin::update_saturated_constraints(Component& comp, int light_pos, double& min_usage)
+{
+  double usage = comp.light_tab[light_pos].remaining_over_usage;
+  xbt_assert(usage > 0, "Impossible");
+
+  if (min_usage < 0 || min_usage > usage) {
+    min_usage = usage;
+    XBT_HERE(" min_usage=%f (cnst->remaining / cnst->usage =%f)", min_usage, usage);
+    comp.saturated_constraints.assign(1, light_pos);
+  } else if (min_usage == usage) {
+    comp.saturated_constraints.emplace_back(light_pos);
+  }
+}
+
+void ArrayMaxMin::update_saturated_variables(Component& comp)
+{
+  for (int const& light_pos : comp.saturated_constraints) {
+    int c   = comp.light_tab[light_pos].cnst;
+    int end = cnst_elem_start_[c];
+    for (int e = cnst_elem_start_[c]; e < cnst_elem_end_[c]; e++) {
+      int v = cnst_elem_var_[e];
+      if (var_fixed_[v])
+        continue;
+      cnst_elem_var_[end]    = v;
+      cnst_elem_weight_[end] = cnst_elem_weight_[e];
+      end++;
+      if (not var_saturated_[v]) {
+        var_saturated_[v] = true;
+        comp.saturated_variables.push_back(v);
+      }
+    }
+    cnst_elem_end_[c] = end;
+  }
+}
+
+void ArrayMaxMin::remove_light(Component& comp, int c)
+{
+  int index = cnst_light_[c];
+  if (index < 0)
+    return;
+  XBT_DEBUG("index: %d \t cnst_light_num: %zu \t || usage: %f remaining: %f bound: %f  ", index,
+            comp.light_tab.size(), cnst_usage_[c], cnst_remaining_[c], cnst_bound_[c]);
+  comp.light_tab[index]                   = comp.light_tab.back();
+  cnst_light_[comp.light_tab[index].cnst] = index;
+  comp.light_tab.pop_back();
+  cnst_light_[c] = -1;
+}
+
+void ArrayMaxMin::progressive_filling(Component& comp)
+{
+  std::vector<LightConstraint>& light_tab = comp.light_tab;
+  double min_usage                        = -1;
+  double min_bound                        = -1;
+
+  for (unsigned pos = 0; pos < light_tab.size(); pos++)
+    update_saturated_constraints(comp, pos, min_usage);
+  update_saturated_variables(comp);
+
+  do {
+    /* First check if some of the saturated variables could reach their upper bound */
+    for (int const& v : comp.saturated_variables) {
+      double bound = var_bound_[v] * var_weight_[v];
+      if ((var_bound_[v] > 0) && (bound < min_usage)) {
+        if (min_bound < 0)
+          min_bound = bound;
+        else
+          min_bound = std::min(min_bound, bound);
+        XBT_DEBUG("Updated min_bound=%f", min_bound);
+      }
+    }
+
+    /* The saturated constraints are really saturated if no variable stops at its bound first */
+    if (min_bound < 0)
+      for (int const& light_pos : comp.saturated_constraints)
+        cnst_level_[light_tab[light_pos].cnst] = min_usage;
+
+    /* Fix the variables that have to be */
+    for (int const& v : comp.saturated_variables) {
+      var_saturated_[v] = false;
+      if (min_bound < 0) {
+        var_value_[v] = min_usage / var_weight_[v];
+      } else if (double_equals(min_bound, var_bound_[v] * var_weight_[v], sg_maxmin_precision)) {
+        var_value_[v] = var_bound_[v];
+      } else {
+        // Variables which bound is different are not considered for this cycle, but they will be afterwards.
+        continue;
+      }
+      var_fixed_[v] = true;
+      var_level_[v] = min_bound < 0 ? min_usage : var_bound_[v] * var_weight_[v];
+      XBT_DEBUG("Setting var (%d) value to %f", var_[v]->id_int, var_value_[v]);
+
+      /* Update the usage of contraints where this variable is involved */
+      for (int e = var_elem_start_[v]; e < var_elem_start_[v + 1]; e++) {
+        int c = var_elem_cnst_[e];
+        if (c < 0)
+          continue;
+        if (var_elem_weight_[e] > 0 && not cnst_skipped_[c])
+          cnst_active_[c]--;
+        if (not cnst_fatpipe_[c]) {
+          // Shared constraints require that sum(elem.value * var.value) < cnst->bound
+          double_update(&cnst_remaining_[c], var_elem_weight_[e] * var_value_[v], cnst_bound_[c] * sg_maxmin_precision);
+          double_update(&cnst_usage_[c], var_elem_weight_[e] / var_weight_[v], sg_maxmin_precision);
+          if (not double_positive(cnst_usage_[c], sg_maxmin_precision) ||
+              not double_positive(cnst_remaining_[c], cnst_bound_[c] * sg_maxmin_precision))
+            remove_light(comp, c);
+          else
+            light_tab[cnst_light_[c]].remaining_over_usage = cnst_remaining_[c] / cnst_usage_[c];
+        } else {
+          // Non-shared constraints only require that max(elem.value * var.value) < cnst->bound
+          cnst_usage_[c] = 0.0;
+          for (int e2 = cnst_elem_start_[c]; e2 < cnst_elem_end_[c]; e2++) {
+            int v2 = cnst_elem_var_[e2];
+            if (not var_fixed_[v2])
+              cnst_usage_[c] = std::max(cnst_usage_[c], cnst_elem_weight_[e2] / var_weight_[v2]);
+          }
+          if (not double_positive(cnst_usage_[c], sg_maxmin_precision) ||
+              not double_positive(cnst_remaining_[c], cnst_bound_[c] * sg_maxmin_precision)) {
+            remove_light(comp, c);
+          } else {
+            light_tab[cnst_light_[c]].remaining_over_usage = cnst_remaining_[c] / cnst_usage_[c];
+            xbt_assert(cnst_active_[c] > 0, "Should not keep a maximum constraint that has no active element! You want "
+                                            "to check the maxmin precision and possible rounding effects.");
+          }
+        }
+      }
+    }
+    comp.saturated_variables.clear();
+
+    /* Find out which variables reach the maximum */
+    min_usage = -1;
+    min_bound = -1;
+    comp.saturated_constraints.clear();
+    for (unsigned pos = 0; pos < light_tab.size(); pos++) {
+      xbt_assert(cnst_active_[light_tab[pos].cnst] > 0,
+                 "Cannot saturate more a constraint that has no active element! You may want to change the maxmin "
+                 "precision (--cfg=maxmin/precision:<new_value>) because of possible rounding effects.\n\tFor the "
+                 "record, the usage of this constraint is %g while the maxmin precision to which it is compared is %g.",
+                 cnst_usage_[light_tab[pos].cnst], sg_maxmin_precision);
+      update_saturated_constraints(comp, pos, min_usage);
+    }
+
+    update_saturated_variables(comp);
+  } while (not light_tab.empty());
+}
+
+void ArrayMaxMin::store_arrays()
+{
+  for (unsigned v = 0; v < var_.size(); v++) {
+    var_[v]->value            = var_value_[v];
+    var_[v]->saturation_level = var_level_[v];
+    var_[v]->solved_weight    = var_weight_[v];
+    var_[v]->solved_bound     = var_bound_[v];
+    var_[v]->array_index      = -1;
+  }
+  for (unsigned c = 0; c < cnst_.size(); c++) {
+    cnst_[c]->remaining   = cnst_remaining_[c];
+    cnst_[c]->usage            = cnst_usage_[c];
+    cnst_[c]->saturation_level = cnst_level_[c];
+    cnst_[c]->array_index      = -1;
+  }
+}
+}
+}
+}
@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/kernel/lmm/maxmin.hpp"
+#include "simgrid/sg_config.hpp"
 #include "src/surf/surf_interface.hpp"
 #include "xbt/backtrace.hpp"
 
@@ -12,6 +13,8 @@ XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_maxmin, surf, "Logging specific to SURF (ma
 double sg_maxmin_precision = 0.00001; /* Change this with --cfg=maxmin/precision:VALUE */
 double sg_surf_precision   = 0.00001; /* Change this with --cfg=surf/precision:VALUE */
 int sg_concurrency_limit   = -1;      /* Change this with --cfg=maxmin/concurrency-limit:VALUE */
+int sg_maxmin_threads            = 1;     /* Change this with --cfg=maxmin/threads:VALUE */
+int sg_maxmin_parallel_threshold = 10000; /* Change this with --cfg=maxmin/parallel-threshold:VALUE */
 
 namespace simgrid {
 namespace kernel {
@@ -24,6 +27,8 @@ int Constraint::Global_debug_id = 1;
 
 System* make_new_maxmin_system(bool selective_update)
 {
+  if (config::get_value<std::string>("maxmin/solver") == "array")
+    return make_new_array_maxmin_system(selective_update);
   return new System(selective_update);
 }
 
@@ -133,7 +138,7 @@ void System::var_free(Variable* var)
 
   check_concurrency();
 
-  xbt_mallocator_release(variable_mallocator_, var);
+  delete var;
   XBT_OUT();
 }
 
@@ -159,7 +164,6 @@ System::~System()
   while ((cnst = extract_constraint()))
     cnst_free(cnst);
 
-  xbt_mallocator_free(variable_mallocator_);
   delete modified_set_;
 }
 
@@ -192,21 +196,11 @@ Constraint* System::constraint_new(void* id, double bound_value)
   return cnst;
 }
 
-void* System::variable_mallocator_new_f()
-{
-  return new Variable;
-}
-
-void System::variable_mallocator_free_f(void* var)
-{
-  delete static_cast<Variable*>(var);
-}
-
 Variable* System::variable_new(resource::Action* id, double sharing_weight, double bound, size_t number_of_constraints)
 {
   XBT_IN("(sys=%p, id=%p, weight=%f, bound=%f, num_cons =%zu)", this, id, sharing_weight, bound, number_of_constraints);
 
-  Variable* var = static_cast<Variable*>(xbt_mallocator_get(variable_mallocator_));
+  Variable* var = new Variable();
   var->initialize(id, sharing_weight, bound, number_of_constraints, visited_counter_ - 1);
   if (sharing_weight > 0)
     variable_set.push_front(*var);
@@ -712,6 +706,10 @@ void Variable::initialize(resource::Action* id_value, double sharing_weight_valu
   visited           = visited_value;
   mu                = 0.0;
   new_mu            = 0.0;
+  array_index       = -1;
+  saturation_level  = std::numeric_limits<double>::infinity();
+  solved_weight     = 0.0;
+  solved_bound      = bound_value;
 
   xbt_assert(not variable_set_hook.is_linked());
   xbt_assert(not saturated_variable_set_hook.is_linked());
@@ -781,6 +779,7 @@ void System::disable_var(Variable* var)
   var->sharing_weight = 0.0;
   var->staged_weight  = 0.0;
   var->value          = 0.0;
+  var->solved_weight  = 0.0; // its previous value is lost, so it must be solved again when enabled
   check_concurrency();
 }
 
@@ -8,15 +8,19 @@
 
 #include "simgrid/kernel/resource/Action.hpp"
 #include "simgrid/s4u/Link.hpp"
+#include "src/include/xbt/slab.hpp"
 #include "xbt/asserts.h"
-#include "xbt/mallocator.h"
 
 #include <boost/intrusive/list.hpp>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <vector>
 
 namespace simgrid {
+namespace xbt {
+template <typename T> class Parmap;
+}
 namespace kernel {
 namespace lmm {
 
@@ -302,6 +306,9 @@ public:
   double lambda;
   double new_lambda;
   ConstraintLight* cnst_light;
+  int array_index = -1; /* used by ArrayMaxMin: position of the constraint in the arrays of the current solve */
+  /* used by ArrayMaxMin: level at which the constraint got saturated during the last solve (infinity if it did not) */
+  double saturation_level = std::numeric_limits<double>::infinity();
 
 private:
   static int Global_debug_id;
@@ -316,7 +323,7 @@ private:
  * When something prevents us from enabling a variable, we "stage" the weight that we would have like to set, so that as
  * soon as possible we enable the variable with desired weight
  */
-class XBT_PUBLIC Variable {
+class XBT_PUBLIC Variable : public xbt::Pooled<Variable> {
 public:
   void initialize(resource::Action* id_value, double sharing_weight_value, double bound_value,
                   int number_of_constraints, unsigned visited_value);
@@ -403,6 +410,12 @@ public:
   double mu;
   double new_mu;
   /* \end{For Lagrange only} */
+  int array_index = -1; /* used by ArrayMaxMin: position of the variable in the arrays of the current solve */
+  /* \begin{For the incremental ArrayMaxMin only} */
+  double saturation_level; /* level at which the variable got fixed during the last solve (infinity if it did not) */
+  double solved_weight;    /* sharing_weight and bound during the last solve, to detect the modified variables */
+  double solved_bound;
+  /* \end{For the incremental ArrayMaxMin only} */
 
 private:
   static int Global_debug_id;
@@ -507,9 +520,6 @@ public:
   virtual void solve() { lmm_solve(); }
 
 private:
-  static void* variable_mallocator_new_f();
-  static void variable_mallocator_free_f(void* var);
-
   void var_free(Variable * var);
   void cnst_free(Constraint * cnst);
   Variable* extract_variable()
@@ -564,12 +574,13 @@ private:
   void update_modified_set(Constraint * cnst);
   void update_modified_set_rec(Constraint * cnst);
 
+  template <class CnstList> void lmm_solve(CnstList& cnst_list);
+
+protected:
   /** @brief Remove all constraints of the modified_constraint_set. */
   void remove_all_modified_set();
   void check_concurrency() const;
 
-  template <class CnstList> void lmm_solve(CnstList& cnst_list);
-
 public:
   bool modified_ = false;
   boost::intrusive::list<Variable, boost::intrusive::member_hook<Variable, boost::intrusive::list_member_hook<>,
@@ -587,18 +598,18 @@ public:
 
   resource::Action::ModifiedSet* modified_set_ = nullptr;
 
-private:
+protected:
   bool selective_update_active; /* flag to update partially the system only selecting changed portions */
+  boost::intrusive::list<Constraint, boost::intrusive::member_hook<Constraint, boost::intrusive::list_member_hook<>,
+                                                                   &Constraint::modified_constraint_set_hook>>
+      modified_constraint_set;
+
+private:
   unsigned visited_counter_ = 1; /* used by System::update_modified_set() and System::remove_all_modified_set() to
                                   * cleverly (un-)flag the constraints (more details in these functions) */
   boost::intrusive::list<Constraint, boost::intrusive::member_hook<Constraint, boost::intrusive::list_member_hook<>,
                                                                    &Constraint::constraint_set_hook>>
       constraint_set;
-  boost::intrusive::list<Constraint, boost::intrusive::member_hook<Constraint, boost::intrusive::list_member_hook<>,
-                                                                   &Constraint::modified_constraint_set_hook>>
-      modified_constraint_set;
-  xbt_mallocator_t variable_mallocator_ =
-      xbt_mallocator_new(65536, System::variable_mallocator_new_f, System::variable_mallocator_free_f, nullptr);
 };
 
 class XBT_PUBLIC FairBottleneck : public System {
@@ -641,7 +652,119 @@ private:
   static double new_mu(const Variable& var);
 };
 
+/**
+ * @brief Max-min solver working on contiguous arrays
+ *
+ * This solver computes exactly the same sharing as System::lmm_solve() (bit for bit), but it first copies the part of
+ * the system that needs to be solved into index-addressed arrays: the bound, remaining and usage of each constraint,
+ * the weight, bound and value of each variable, and the incidence between both in a compressed (CSR) form. The
+ * progressive filling then only walks these arrays instead of chasing the intrusive lists of the system. The arrays
+ * are kept from one solve to the next to avoid any allocation in steady state.
+ *
+ * When --cfg=maxmin/threads is larger than 1, the system is first split into its connected components (sets of
+ * constraints sharing variables, transitively). Their progressive fillings are independent, so they are run
+ * concurrently on a pool of threads when the system is large enough (see --cfg=maxmin/parallel-threshold), and one
+ * after the other otherwise. The component split does not depend on the amount of threads, so the computed sharing is
+ * the same whatever the amount of threads.
+ *
+ * With --cfg=maxmin/incremental:yes, each solve is warm-started from the previous solution. The progressive filling
+ * fixes the variables by increasing level, and the changes made to the system since the last solve can only alter this
+ * process above a given level. The variables fixed below that level keep their previous value, and only the remaining
+ * part of the system is filled again. The result is then the same as a full solve, up to the solver precision.
+ *
+ * Select it with --cfg=maxmin/solver:array
+ */
+class XBT_PUBLIC ArrayMaxMin : public System {
+public:
+  explicit ArrayMaxMin(bool selective_update);
+  ~ArrayMaxMin();
+  void solve() final { array_solve(); }
+
+private:
+  struct LightConstraint {
+    double remaining_over_usage;
+    int cnst;
+  };
+
+  /* A part of the system that can be solved independently of the others */
+  struct Component {
+    std::vector<LightConstraint> light_tab;
+    std::vector<int> saturated_constraints;
+    std::vector<int> saturated_variables;
+    int elements = 0; // amount of active elements, used to start with the largest components
+  };
+
+  void array_solve();
+  template <class CnstList> void array_solve(CnstList& cnst_list);
+  template <class CnstList> void load_arrays(CnstList& cnst_list);
+  void warm_start();
+  double first_change(int cnst);
+  double shared_saturation_level(int cnst);
+  void split_components();
+  void solve_components();
+  void update_saturated_constraints(Component& comp, int light_pos, double& min_usage);
+  void update_saturated_variables(Component& comp);
+  void remove_light(Component& comp, int cnst);
+  void progressive_filling(Component& comp);
+  void store_arrays();
+
+  /* Constraints (indexed by Constraint::array_index) */
+  std::vector<Constraint*> cnst_;
+  std::vector<double> cnst_bound_;
+  std::vector<double> cnst_remaining_;
+  std::vector<double> cnst_usage_;
+  std::vector<char> cnst_fatpipe_;
+  std::vector<char> cnst_skipped_; // remaining was not positive when the solve started
+  std::vector<int> cnst_light_;    // position in the light_tab of its component, or -1
+  std::vector<int> cnst_component_;
+  std::vector<int> cnst_active_;   // amount of active elements
+  std::vector<double> cnst_level_; // level at which it got saturated (infinity if it did not)
+  // Active elements of each constraint, in [cnst_elem_start_[c], cnst_elem_end_[c]). The end is moved down as the
+  // variables get fixed.
+  std::vector<int> cnst_elem_start_;
+  std::vector<int> cnst_elem_end_;
+  std::vector<int> cnst_elem_var_;
+  std::vector<double> cnst_elem_weight_;
+
+  /* Variables (indexed by Variable::array_index) */
+  std::vector<Variable*> var_;
+  std::vector<double> var_weight_;
+  std::vector<double> var_bound_;
+  std::vector<double> var_value_;
+  std::vector<char> var_fixed_;
+  std::vector<char> var_saturated_;
+  std::vector<double> var_level_; // level at which it got fixed (infinity if it did not)
+  // Elements of each variable, in [var_elem_start_[v], var_elem_start_[v+1])
+  std::vector<int> var_elem_start_;
+  std::vector<int> var_elem_cnst_;
+  std::vector<double> var_elem_weight_;
+
+  /* All enabled elements, in the order of the constraints. Only used to build the incidence of the variables. */
+  std::vector<int> cnst_enabled_start_;
+  std::vector<int> enabled_var_;
+  std::vector<int> enabled_rank_; // rank of the element in Variable::cnsts
+  std::vector<double> enabled_weight_;
+
+  /* Constraints that need to be saturated, before being dispatched to their component */
+  std::vector<LightConstraint> light_tab_;
+
+  /* Warm start: level at which each variable got fixed in the previous solve, and its value at that time (or the
+   * level of its bound and its bound if it was modified since then) */
+  bool incremental_;
+  std::vector<double> var_prev_level_;
+  std::vector<double> var_prev_value_;
+  std::vector<char> var_modified_;
+  std::vector<std::pair<double, int>> level_order_;
+
+  /* Scratch space of the progressive filling, kept across solves */
+  std::vector<Component> components_;
+  std::vector<Component*> schedule_;
+  std::unique_ptr<xbt::Parmap<Component*>> parmap_;
+  int parmap_threads_ = 0;
+};
+
 XBT_PUBLIC System* make_new_maxmin_system(bool selective_update);
+XBT_PUBLIC System* make_new_array_maxmin_system(bool selective_update);
 XBT_PUBLIC System* make_new_fair_bottleneck_system(bool selective_update);
 XBT_PUBLIC System* make_new_lagrange_system(bool selective_update);
 
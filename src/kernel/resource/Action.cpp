@@ -5,10 +5,13 @@
 
 #include "simgrid/kernel/resource/Action.hpp"
 #include "simgrid/kernel/resource/Model.hpp"
+#include "simgrid/sg_config.hpp"
 #include "src/kernel/lmm/maxmin.hpp"
 #include "src/surf/surf_interface.hpp"
 #include "surf/surf.hpp"
 
+#include <algorithm>
+
 XBT_LOG_NEW_CATEGORY(kernel, "Logging specific to the internals of SimGrid");
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(resource, kernel, "Logging specific to the resources");
 
@@ -206,40 +209,123 @@ void Action::set_last_update()
   last_update_ = surf_get_clock();
 }
 
+ActionHeap::ActionHeap()
+    : kind_(config::get_value<std::string>("surf/action-heap") == "pairing" ? Kind::pairing : Kind::four_ary)
+{
+}
+
 double ActionHeap::top_date() const
 {
-  return top().first;
+  if (kind_ == Kind::pairing)
+    return pairing_heap_.top().first;
+  return nodes_.front().date;
 }
+
 void ActionHeap::insert(Action* action, double date, ActionHeap::Type type)
 {
-  action->type_      = type;
-  action->heap_hook_ = emplace(std::make_pair(date, action));
+  action->type_ = type;
+  if (kind_ == Kind::pairing) {
+    action->heap_hook_ = pairing_heap_.emplace(std::make_pair(date, action));
+  } else {
+    nodes_.push_back(Node{date, ++stamp_, action});
+    action->heap_index_ = static_cast<int>(nodes_.size() - 1);
+    sift_up(nodes_.size() - 1);
+  }
 }
+
 void ActionHeap::remove(Action* action)
 {
   action->type_ = ActionHeap::Type::unset;
   if (action->heap_hook_) {
-    erase(*action->heap_hook_);
+    pairing_heap_.erase(*action->heap_hook_);
     action->heap_hook_ = boost::none;
   }
+  if (action->heap_index_ >= 0)
+    erase_at(action->heap_index_);
 }
+
 void ActionHeap::update(Action* action, double date, ActionHeap::Type type)
 {
   action->type_ = type;
   if (action->heap_hook_) {
-    heap_type::update(*action->heap_hook_, std::make_pair(date, action));
+    pairing_heap_.update(*action->heap_hook_, std::make_pair(date, action));
+  } else if (action->heap_index_ >= 0) {
+    unsigned pos      = action->heap_index_;
+    nodes_[pos].date  = date;
+    nodes_[pos].stamp = ++stamp_;
+    sift_up(pos);
+    sift_down(action->heap_index_);
   } else {
-    action->heap_hook_ = emplace(std::make_pair(date, action));
+    insert(action, date, type);
   }
 }
+
 Action* ActionHeap::pop()
 {
-  Action* action = top().second;
-  heap_type::pop();
-  action->heap_hook_ = boost::none;
+  Action* action;
+  if (kind_ == Kind::pairing) {
+    action = pairing_heap_.top().second;
+    pairing_heap_.pop();
+    action->heap_hook_ = boost::none;
+  } else {
+    action = nodes_.front().action;
+    erase_at(0);
+  }
   return action;
 }
 
+void ActionHeap::place(unsigned pos, const Node& node)
+{
+  nodes_[pos]              = node;
+  node.action->heap_index_ = pos;
+}
+
+void ActionHeap::sift_up(unsigned pos)
+{
+  Node node = nodes_[pos];
+  while (pos > 0) {
+    unsigned parent = (pos - 1) / arity;
+    if (not(node < nodes_[parent]))
+      break;
+    place(pos, nodes_[parent]);
+    pos = parent;
+  }
+  place(pos, node);
+}
+
+void ActionHeap::sift_down(unsigned pos)
+{
+  Node node    = nodes_[pos];
+  size_t count = nodes_.size();
+  while (true) {
+    size_t first = arity * pos + 1;
+    if (first >= count)
+      break;
+    size_t last = std::min(first + arity, count);
+    size_t best = first;
+    for (size_t child = first + 1; child < last; child++)
+      if (nodes_[child] < nodes_[best])
+        best = child;
+    if (not(nodes_[best] < node))
+      break;
+    place(pos, nodes_[best]);
+    pos = best;
+  }
+  place(pos, node);
+}
+
+void ActionHeap::erase_at(unsigned pos)
+{
+  nodes_[pos].action->heap_index_ = -1;
+  Node last                       = nodes_.back();
+  nodes_.pop_back();
+  if (pos < nodes_.size()) {
+    nodes_[pos] = last;
+    sift_up(pos);
+    sift_down(last.action->heap_index_);
+  }
+}
+
 } // namespace surf
 } // namespace kernel
 } // namespace simgrid
@@ -6,20 +6,38 @@
 #include "xbt/log.h"
 #include "xbt/sysdep.h"
 
+#include "src/internal_config.h"
 #include "src/kernel/resource/profile/trace_mgr.hpp"
 #include "src/surf/surf_interface.hpp"
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
-#include <fstream>
-#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <unordered_map>
 
+#include <sys/stat.h>
+#if HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(profile, resource, "Surf profile management");
 
 static std::unordered_map<std::string, simgrid::kernel::profile::Profile*> trace_list;
 
+/* The binary profiles start with this header, followed by the dated values as pairs of native doubles */
+namespace {
+struct BinaryHeader {
+  char magic[8];
+  std::uint64_t count;
+};
+constexpr char binary_magic[8] = "SGPROF1";
+} // namespace
+
 namespace simgrid {
 namespace kernel {
 namespace profile {
@@ -40,7 +58,13 @@ Profile::Profile()
   DatedValue val(0, -1);
   event_list.push_back(val);
 }
-Profile::~Profile()          = default;
+Profile::~Profile()
+{
+#if HAVE_MMAP
+  if (mapping_ != nullptr)
+    munmap(mapping_, mapping_size_);
+#endif
+}
 
 /** @brief Register this profile for that resource onto that FES,
  * and get an iterator over the integrated trace  */
@@ -52,7 +76,7 @@ Event* Profile::schedule(FutureEvtSet* fes, resource::Resource* resource)
   event->resource = resource;
   event->free_me  = false;
 
-  xbt_assert((event->idx < event_list.size()), "Your profile should have at least one event!");
+  xbt_assert((event->idx < get_events().size()), "Your profile should have at least one event!");
 
   fes_ = fes;
   fes_->add_event(0.0 /* start time */, event);
@@ -64,9 +88,11 @@ Event* Profile::schedule(FutureEvtSet* fes, resource::Resource* resource)
 DatedValue Profile::next(Event* event)
 {
   double event_date  = fes_->next_date();
-  DatedValue dateVal = event_list.at(event->idx);
+  auto events         = get_events();
+  xbt_assert(event->idx < events.size());
+  DatedValue dateVal = events[event->idx];
 
-  if (event->idx < event_list.size() - 1) {
+  if (event->idx < events.size() - 1) {
     fes_->add_event(event_date + dateVal.date_, event);
     event->idx++;
   } else if (dateVal.date_ > 0) { /* Last element. Shall we loop? */
@@ -126,56 +152,202 @@ Profile* Profile::from_string(const std::string& name, const std::string& input,
 Profile* Profile::from_file(const std::string& path)
 {
   xbt_assert(not path.empty(), "Cannot parse a trace from an empty filename");
-  xbt_assert(trace_list.find(path) == trace_list.end(), "Refusing to define trace %s twice", path.c_str());
+  auto known = trace_list.find(path);
+  if (known != trace_list.end()) {
+    XBT_DEBUG("Profile %s already loaded, sharing it", path.c_str());
+    return known->second;
+  }
+
+  FILE* f = surf_fopen(path, "rb");
+  xbt_assert(f != nullptr, "Cannot open file '%s' (path=%s)", path.c_str(), (boost::join(surf_path, ":")).c_str());
+
+  char buffer[4096];
+  size_t count = fread(buffer, 1, sizeof(binary_magic), f);
+  if (count == sizeof(binary_magic) && memcmp(buffer, binary_magic, sizeof(binary_magic)) == 0) {
+    Profile* profile = from_binary(path, f);
+    fclose(f);
+    return profile;
+  }
 
-  std::ifstream* f = surf_ifsopen(path);
-  xbt_assert(not f->fail(), "Cannot open file '%s' (path=%s)", path.c_str(), (boost::join(surf_path, ":")).c_str());
+  std::string input(buffer, count);
+  while ((count = fread(buffer, 1, sizeof(buffer), f)) > 0)
+    input.append(buffer, count);
+  fclose(f);
 
-  std::stringstream buffer;
-  buffer << f->rdbuf();
-  delete f;
+  return Profile::from_string(path, input, -1);
+}
+
+/** @brief Loads a profile written by write_binary(), the file being positioned right after the magic number */
+Profile* Profile::from_binary(const std::string& path, FILE* file)
+{
+  static_assert(sizeof(DatedValue) == 2 * sizeof(double), "DatedValue cannot be mapped from binary files");
+  std::uint64_t count;
+  xbt_assert(fread(&count, sizeof(count), 1, file) == 1 && count > 0, "%s: Invalid binary profile (no event)",
+             path.c_str());
+  size_t size = sizeof(BinaryHeader) + count * sizeof(DatedValue);
+  struct stat st;
+  xbt_assert(fstat(fileno(file), &st) == 0 && static_cast<size_t>(st.st_size) == size,
+             "%s: Invalid binary profile (%llu events need %zu bytes)", path.c_str(),
+             static_cast<unsigned long long>(count), size);
+
+  Profile* profile = new Profile();
+  profile->event_list.clear();
+#if HAVE_MMAP
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+  xbt_assert(mapping != MAP_FAILED, "Cannot map the profile %s: %s", path.c_str(), strerror(errno));
+  profile->mapping_       = mapping;
+  profile->mapping_size_  = size;
+  profile->mapped_events_ = reinterpret_cast<const DatedValue*>(static_cast<char*>(mapping) + sizeof(BinaryHeader));
+  profile->mapped_count_  = count;
+#else
+  profile->event_list.resize(count);
+  xbt_assert(fread(profile->event_list.data(), sizeof(DatedValue), count, file) == count,
+             "%s: Invalid binary profile (truncated)", path.c_str());
+#endif
+  XBT_DEBUG("Loaded %llu events from the binary profile %s", static_cast<unsigned long long>(count), path.c_str());
+
+  trace_list.insert({path, profile});
+  return profile;
+}
 
-  return Profile::from_string(path, buffer.str(), -1);
+/** @brief Saves this profile in the binary format, which from_file() maps in memory instead of parsing it
+ *
+ * The dated values are written as pairs of native doubles, so the files are not portable across architectures.
+ */
+void Profile::write_binary(const std::string& path) const
+{
+  auto events = get_events();
+  BinaryHeader header;
+  memcpy(header.magic, binary_magic, sizeof(binary_magic));
+  header.count = events.size();
+
+  FILE* f = fopen(path.c_str(), "wb");
+  xbt_assert(f != nullptr, "Cannot open file '%s' for writing: %s", path.c_str(), strerror(errno));
+  bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+            fwrite(events.begin(), sizeof(DatedValue), events.size(), f) == events.size();
+  ok      = (fclose(f) == 0) && ok;
+  xbt_assert(ok, "Cannot write the profile to '%s': %s", path.c_str(), strerror(errno));
 }
-FutureEvtSet::FutureEvtSet() = default;
+
+FutureEvtSet::FutureEvtSet() : buckets_(2) {}
 FutureEvtSet::~FutureEvtSet()
 {
-  while (not heap_.empty()) {
-    delete heap_.top().second;
-    heap_.pop();
+  for (auto const& bucket : buckets_)
+    for (auto const& elt : bucket)
+      delete elt.event;
+}
+
+std::vector<FutureEvtSet::Qelt>& FutureEvtSet::bucket_of(double slot)
+{
+  return buckets_[static_cast<uint64_t>(slot) & (buckets_.size() - 1)];
+}
+
+/** @brief Moves first_slot_ forward to the slot of the next event */
+void FutureEvtSet::seek_next()
+{
+  if (size_ == 0)
+    return;
+  for (size_t i = 0; i < buckets_.size(); i++, first_slot_ += 1.0) {
+    std::vector<Qelt> const& bucket = bucket_of(first_slot_);
+    if (not bucket.empty() && slot_of(bucket.front().date) == first_slot_)
+      return;
   }
+  /* The next event is more than one round of the calendar away: search it directly */
+  Qelt const* first = nullptr;
+  for (auto const& bucket : buckets_)
+    if (not bucket.empty() && (first == nullptr || *first > bucket.front()))
+      first = &bucket.front();
+  first_slot_ = slot_of(first->date);
+}
+
+/** @brief Changes the amount of buckets, and adapts their width to the spacing of the last retrieved events */
+void FutureEvtSet::resize(size_t bucket_count)
+{
+  if (gap_count_ > 0) {
+    width_     = ideal_width();
+    gap_sum_   = 0.0;
+    gap_count_ = 0;
+  }
+  pops_ = 0;
+
+  std::vector<std::vector<Qelt>> old_buckets(bucket_count);
+  std::swap(buckets_, old_buckets);
+  first_slot_ = std::numeric_limits<double>::infinity();
+  for (auto const& bucket : old_buckets)
+    for (auto const& elt : bucket) {
+      double slot = slot_of(elt.date);
+      bucket_of(slot).push_back(elt);
+      first_slot_ = std::min(first_slot_, slot);
+    }
+  for (auto& bucket : buckets_)
+    std::make_heap(bucket.begin(), bucket.end(), std::greater<Qelt>());
 }
 
 /** @brief Schedules an event to a future date */
 void FutureEvtSet::add_event(double date, Event* evt)
 {
-  heap_.emplace(date, evt);
+  Qelt elt{date, evt};
+  double slot = slot_of(date);
+  if (size_ == 0 || slot < first_slot_)
+    first_slot_ = slot;
+  std::vector<Qelt>& bucket = bucket_of(slot);
+  bucket.push_back(elt);
+  std::push_heap(bucket.begin(), bucket.end(), std::greater<Qelt>());
+  size_++;
+  if (size_ > 2 * buckets_.size())
+    resize(2 * buckets_.size());
 }
 
 /** @brief returns the date of the next occurring event (or -1 if empty) */
 double FutureEvtSet::next_date() const
 {
-  return heap_.empty() ? -1.0 : heap_.top().first;
+  if (size_ == 0)
+    return -1.0;
+  return buckets_[static_cast<uint64_t>(first_slot_) & (buckets_.size() - 1)].front().date;
 }
 
 /** @brief Retrieves the next occurring event, or nullptr if none happens before date */
 Event* FutureEvtSet::pop_leq(double date, double* value, resource::Resource** resource)
 {
   double event_date = next_date();
-  if (event_date > date || heap_.empty())
+  if (event_date > date || size_ == 0)
     return nullptr;
 
-  Event* event = heap_.top().second;
+  Event* event = bucket_of(first_slot_).front().event;
   Profile* profile = event->profile;
   DatedValue dateVal = profile->next(event);
 
   *resource = event->resource;
   *value = dateVal.value_;
 
-  heap_.pop();
+  if (event_date > last_date_) {
+    gap_sum_ += event_date - last_date_;
+    gap_count_++;
+    last_date_ = event_date;
+  }
+
+  std::vector<Qelt>& bucket = bucket_of(first_slot_);
+  std::pop_heap(bucket.begin(), bucket.end(), std::greater<Qelt>());
+  bucket.pop_back();
+  size_--;
+  pops_++;
+  if (buckets_.size() > 2 && size_ < buckets_.size() / 2)
+    resize(buckets_.size() / 2);
+  else if (pops_ > size_ && gap_count_ > 0 && width_is_off())
+    resize(buckets_.size()); // Every event was retrieved since the last resize: check the width of the buckets
+  else
+    seek_next();
 
   return event;
 }
+
+/** @brief Retrieves all the events occurring before date, in the order in which pop_leq() would return them */
+void FutureEvtSet::pop_all_leq(double date, std::vector<FiredEvent>& events)
+{
+  FiredEvent fired;
+  while ((fired.event = pop_leq(date, &fired.value, &fired.resource)))
+    events.push_back(fired);
+}
 } // namespace profile
 } // namespace kernel
 } // namespace simgrid
@@ -9,7 +9,11 @@
 #include "simgrid/forward.h"
 #include "xbt/sysdep.h"
 
-#include <queue>
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <vector>
 
 /* Iterator within a trace */
@@ -71,26 +75,60 @@ std::ostream& operator<<(std::ostream& out, const DatedValue& e);
  * It is useful to model dynamic platforms, where an external load that makes the resource availability change over
  * time. To model that, you have to set several profiles per resource: one for the on/off state and one for each
  * numerical value (computational speed, bandwidth and/or latency).
+ *
+ * A profile loaded from a file is shared by all the resources using this file. The file can either be written in the
+ * text format, or in a binary format (see write_binary()) that is mapped in memory instead of being parsed.
  */
 class XBT_PUBLIC Profile {
 public:
   /**  Creates an empty trace */
   explicit Profile();
+  Profile(const Profile&) = delete;
+  Profile& operator=(const Profile&) = delete;
   virtual ~Profile();
   Event* schedule(FutureEvtSet* fes, resource::Resource* resource);
   DatedValue next(Event* event);
 
+  /** @brief The dated values of this profile, the date of each of them being the delay until the next one.
+   *  The first one is a placeholder storing the date at which the profile starts. */
+  boost::iterator_range<const DatedValue*> get_events() const
+  {
+    if (mapped_events_ != nullptr)
+      return boost::make_iterator_range(mapped_events_, mapped_events_ + mapped_count_);
+    return boost::make_iterator_range(event_list.data(), event_list.data() + event_list.size());
+  }
+  void write_binary(const std::string& path) const;
+
   static Profile* from_file(const std::string& path);
   static Profile* from_string(const std::string& name, const std::string& input, double periodicity);
   // private:
-  std::vector<DatedValue> event_list;
+  std::vector<DatedValue> event_list; // Unused when the profile is mapped from a binary file
 
 private:
-  FutureEvtSet* fes_ = nullptr;
+  static Profile* from_binary(const std::string& path, FILE* file);
+
+  FutureEvtSet* fes_               = nullptr;
+  const DatedValue* mapped_events_ = nullptr;
+  size_t mapped_count_             = 0;
+  void* mapping_                   = nullptr;
+  size_t mapping_size_             = 0;
+};
+
+/** @brief An event retrieved from the Future Event Set, along with the value that it gives to its resource */
+struct FiredEvent {
+  Event* event;
+  resource::Resource* resource;
+  double value;
 };
 
 /** @brief Future Event Set (collection of iterators over the traces)
- * That's useful to quickly know which is the next occurring event in a set of traces. */
+ * That's useful to quickly know which is the next occurring event in a set of traces.
+ *
+ * The events are stored in a calendar queue: an array of buckets, each of them covering a time interval of the same
+ * width, the array wrapping around as time goes by. The width is adapted to the spacing of the dates at which the
+ * (usually periodic) profiles of the platform fire, so that each bucket only holds a few distinct dates. Events
+ * occurring at the same date are retrieved by increasing address, as with the binary heap used previously.
+ */
 class XBT_PUBLIC FutureEvtSet {
 public:
   FutureEvtSet();
@@ -99,11 +137,35 @@ public:
   virtual ~FutureEvtSet();
   double next_date() const;
   Event* pop_leq(double date, double* value, resource::Resource** resource);
+  void pop_all_leq(double date, std::vector<FiredEvent>& events);
   void add_event(double date, Event* evt);
 
 private:
-  typedef std::pair<double, Event*> Qelt;
-  std::priority_queue<Qelt, std::vector<Qelt>, std::greater<Qelt>> heap_;
+  struct Qelt {
+    double date;
+    Event* event;
+    /* Each bucket is a binary heap, the next event being at its front */
+    bool operator>(const Qelt& other) const
+    {
+      return date > other.date || (date == other.date && event > other.event);
+    }
+  };
+  double slot_of(double date) const { return std::floor(date / width_); }
+  std::vector<Qelt>& bucket_of(double slot);
+  void seek_next();
+  void resize(size_t bucket_count);
+  /* A few distinct dates per bucket. Keep the slot numbers small enough to be exactly represented by a double. */
+  double ideal_width() const { return std::max(3 * gap_sum_ / gap_count_, last_date_ / 1e12); }
+  bool width_is_off() const { return ideal_width() > 2 * width_ || 2 * ideal_width() < width_; }
+
+  std::vector<std::vector<Qelt>> buckets_; // always a power of 2
+  double width_       = 1.0;
+  double first_slot_  = 0.0; // slot of the next event, which is at the front of its bucket
+  size_t size_        = 0;
+  size_t pops_        = 0;   // events retrieved since the last resize
+  double last_date_   = 0.0; // date of the last retrieved event
+  double gap_sum_     = 0.0; // sum and count of the gaps between the distinct dates retrieved since the last resize
+  unsigned gap_count_ = 0;
 };
 
 } // namespace profile
@@ -13,6 +13,8 @@
 #include "xbt/misc.h"
 
 #include <cmath>
+#include <cstdio>
+#include <unistd.h>
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(unit, "Unit tests of the Trace Manager");
 
@@ -142,3 +144,65 @@ TEST_CASE("kernel::profile: Resource profiles, defining the external load", "ker
     REQUIRE(want == got);
   }
 }
+
+TEST_CASE("kernel::profile: Future Event Set, retrieving the events of many profiles", "kernel::profile")
+{
+  SECTION("Periodic profiles, retrieved in batches")
+  {
+    MockedResource daResource;
+    simgrid::kernel::profile::FutureEvtSet fes;
+    for (int period = 1; period <= 50; period++) {
+      simgrid::kernel::profile::Profile* trace = simgrid::kernel::profile::Profile::from_string(
+          "Periodic" + std::to_string(period), "0.0 " + std::to_string(period) + "\n", period);
+      trace->schedule(&fes, &daResource);
+    }
+
+    std::vector<int> got(51, 0);
+    std::vector<simgrid::kernel::profile::FiredEvent> events;
+    double previous = 0;
+    while (fes.next_date() <= 1000.0 && fes.next_date() >= 0) {
+      thedate = fes.next_date();
+      REQUIRE(thedate >= previous);
+      previous = thedate;
+      events.clear();
+      fes.pop_all_leq(thedate, events);
+      REQUIRE(not events.empty());
+      for (auto const& fired : events) {
+        if (fired.value < 0) // The first event of each profile only stores its start time
+          continue;
+        int period = static_cast<int>(fired.value);
+        REQUIRE(std::fmod(thedate, period) == 0.0); // Check that each profile fires at the right dates
+        got[period]++;
+        fired.resource->apply_event(fired.event, fired.value);
+      }
+      REQUIRE(fes.next_date() > thedate);
+    }
+    tmgr_finalize();
+
+    for (int period = 1; period <= 50; period++)
+      REQUIRE(got[period] == 1000 / period + 1);
+  }
+}
+
+TEST_CASE("kernel::profile: Binary profiles, mapped in memory", "kernel::profile")
+{
+  SECTION("Same values as the text profile")
+  {
+    simgrid::kernel::profile::Profile* text =
+        simgrid::kernel::profile::Profile::from_string("TheText", "1.0 1.0\n3.0 3.0\nLOOPAFTER 2\n", 0);
+    char cwd[1024];
+    REQUIRE(getcwd(cwd, sizeof(cwd)) != nullptr);
+    std::string path = std::string(cwd) + "/unit_tests_profile.bin"; // No search path is set in unit tests
+    text->write_binary(path);
+
+    simgrid::kernel::profile::Profile* binary = simgrid::kernel::profile::Profile::from_file(path);
+    REQUIRE(simgrid::kernel::profile::Profile::from_file(path) == binary); // Loaded only once
+    REQUIRE(binary->event_list.empty());                                    // Mapped, not parsed
+    std::vector<simgrid::kernel::profile::DatedValue> want(text->get_events().begin(), text->get_events().end());
+    std::vector<simgrid::kernel::profile::DatedValue> got(binary->get_events().begin(), binary->get_events().end());
+    REQUIRE(want == got);
+
+    tmgr_finalize();
+    remove(path.c_str());
+  }
+}
@@ -5,16 +5,30 @@
 
 #include "simgrid/kernel/routing/DijkstraZone.hpp"
 #include "simgrid/kernel/routing/NetPoint.hpp"
+#include "simgrid/sg_config.hpp"
+#include "src/include/xbt/parmap.hpp"
 #include "src/surf/network_interface.hpp"
+#include "src/surf/surf_interface.hpp"
 #include "src/surf/xml/platf_private.hpp"
 #include "surf/surf.hpp"
 
+#include <algorithm>
 #include <cfloat>
+#include <limits>
 #include <queue>
 #include <vector>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_route_dijkstra, surf, "Routing part of surf -- dijkstra routing logic");
 
+static simgrid::config::Flag<bool> cfg_dijkstra_precompute{
+    "network/dijkstra-precompute",
+    "Whether the Dijkstra zones compute the paths from all their nodes when they are sealed, instead of on need", false};
+
+/* The zones that are smaller than that always compute their paths sequentially */
+static constexpr unsigned int PARALLEL_PRECOMPUTE_THRESHOLD = 256;
+/* Amount of sources handled at once by a thread */
+static constexpr unsigned int SOURCES_PER_BLOCK = 16;
+
 namespace simgrid {
 namespace kernel {
 namespace routing {
@@ -83,6 +97,112 @@ void DijkstraZone::seal()
     GraphNodeData* data = static_cast<GraphNodeData*>(xbt_graph_node_get_data(node));
     data->graph_id_     = cursor;
   }
+
+  /* compress the graph, keeping the edges in the order of the xbt_graph */
+  edge_start_.assign(1, 0);
+  xbt_dynar_foreach (nodes, cursor, node) {
+    xbt_edge_t edge = nullptr;
+    unsigned int cursor2;
+    xbt_dynar_foreach (xbt_graph_node_get_outedges(node), cursor2, edge) {
+      xbt_node_t target = xbt_graph_edge_get_target(edge);
+      edge_target_.push_back(static_cast<GraphNodeData*>(xbt_graph_node_get_data(target))->graph_id_);
+      edge_route_.push_back(static_cast<RouteCreationArgs*>(xbt_graph_edge_get_data(edge)));
+    }
+    edge_start_.push_back(edge_target_.size());
+  }
+
+  if (cfg_dijkstra_precompute)
+    precompute_predecessors();
+}
+
+RouteCreationArgs* DijkstraZone::get_edge_route(int src_node_id, int dst_node_id)
+{
+  for (unsigned int i = edge_start_[src_node_id]; i < edge_start_[src_node_id + 1]; i++)
+    if (edge_target_[i] == static_cast<unsigned int>(dst_node_id))
+      return edge_route_[i];
+  return nullptr;
+}
+
+void DijkstraZone::compute_predecessors(int src_node_id, std::vector<int>& pred_arr)
+{
+  int nr_nodes = edge_start_.size() - 1;
+  std::vector<double> cost_arr(nr_nodes); /* link cost from src to other hosts */
+  pred_arr.resize(nr_nodes);              /* predecessors in path from src */
+  typedef std::pair<double, int> Qelt;
+  std::priority_queue<Qelt, std::vector<Qelt>, std::greater<Qelt>> pqueue;
+
+  /* initialize */
+  cost_arr[src_node_id] = 0.0;
+
+  for (int i = 0; i < nr_nodes; i++) {
+    if (i != src_node_id) {
+      cost_arr[i] = DBL_MAX;
+    }
+
+    pred_arr[i] = 0;
+
+    /* initialize priority queue */
+    pqueue.emplace(cost_arr[i], i);
+  }
+
+  /* apply dijkstra using the indexes from the graph's node array */
+  while (not pqueue.empty()) {
+    int v_id = pqueue.top().second;
+    pqueue.pop();
+
+    for (unsigned int i = edge_start_[v_id]; i < edge_start_[v_id + 1]; i++) {
+      int u_id     = edge_target_[i];
+      int cost_v_u = edge_route_[i]->link_list.size(); /* count of links, old model assume 1 */
+
+      if (cost_v_u + cost_arr[v_id] < cost_arr[u_id]) {
+        pred_arr[u_id] = v_id;
+        cost_arr[u_id] = cost_v_u + cost_arr[v_id];
+        pqueue.emplace(cost_arr[u_id], u_id);
+      }
+    }
+  }
+}
+
+/* Computes the paths from every node of the graph, splitting the sources over the threads of
+ * --cfg=network/routing-threads */
+void DijkstraZone::precompute_predecessors()
+{
+  unsigned int nr_nodes = edge_start_.size() - 1;
+  size_t table_size     = static_cast<size_t>(nr_nodes) * nr_nodes;
+  if (nr_nodes <= std::numeric_limits<uint16_t>::max() + 1U)
+    short_predecessor_table_.resize(table_size);
+  else
+    predecessor_table_.resize(table_size);
+
+  std::vector<unsigned int> blocks;
+  for (unsigned int first = 0; first < nr_nodes; first += SOURCES_PER_BLOCK)
+    blocks.push_back(first);
+  auto compute_block = [this, nr_nodes](unsigned int first) {
+    std::vector<int> pred_arr;
+    for (unsigned int src = first; src < std::min(first + SOURCES_PER_BLOCK, nr_nodes); src++) {
+      compute_predecessors(src, pred_arr);
+      size_t row = static_cast<size_t>(src) * nr_nodes;
+      if (predecessor_table_.empty())
+        std::copy(pred_arr.begin(), pred_arr.end(), short_predecessor_table_.begin() + row);
+      else
+        std::copy(pred_arr.begin(), pred_arr.end(), predecessor_table_.begin() + row);
+    }
+  };
+
+  if (sg_routing_threads > 1 && nr_nodes >= PARALLEL_PRECOMPUTE_THRESHOLD) {
+    xbt::Parmap<unsigned int> parmap(sg_routing_threads, XBT_PARMAP_DEFAULT);
+    parmap.apply(compute_block, blocks);
+  } else {
+    for (unsigned int first : blocks)
+      compute_block(first);
+  }
+  XBT_DEBUG("Precomputed the paths from the %u nodes of %s", nr_nodes, get_cname());
+}
+
+int DijkstraZone::get_predecessor(int src_node_id, int node_id)
+{
+  size_t index = static_cast<size_t>(src_node_id) * (edge_start_.size() - 1) + node_id;
+  return predecessor_table_.empty() ? short_predecessor_table_[index] : predecessor_table_[index];
 }
 
 xbt_node_t DijkstraZone::route_graph_new_node(int id)
@@ -107,8 +227,6 @@ void DijkstraZone::get_local_route(NetPoint* src, NetPoint* dst, RouteCreationAr
   int src_id = src->id();
   int dst_id = dst->id();
 
-  xbt_dynar_t nodes = xbt_graph_get_nodes(route_graph_);
-
   /* Use the graph_node id mapping set to quickly find the nodes */
   xbt_node_t src_elm = node_map_search(src_id);
   xbt_node_t dst_elm = node_map_search(dst_id);
@@ -118,16 +236,11 @@ void DijkstraZone::get_local_route(NetPoint* src, NetPoint* dst, RouteCreationAr
 
   /* if the src and dst are the same */
   if (src_node_id == dst_node_id) {
+    RouteCreationArgs* e_route = get_edge_route(src_node_id, dst_node_id);
 
-    xbt_node_t node_s_v = xbt_dynar_get_as(nodes, src_node_id, xbt_node_t);
-    xbt_node_t node_e_v = xbt_dynar_get_as(nodes, dst_node_id, xbt_node_t);
-    xbt_edge_t edge     = xbt_graph_get_edge(route_graph_, node_s_v, node_e_v);
-
-    if (edge == nullptr)
+    if (e_route == nullptr)
       THROWF(arg_error, 0, "No route from '%s' to '%s'", src->get_cname(), dst->get_cname());
 
-    RouteCreationArgs* e_route = static_cast<RouteCreationArgs*>(xbt_graph_edge_get_data(edge));
-
     for (auto const& link : e_route->link_list) {
       route->link_list.insert(route->link_list.begin(), link);
       if (lat)
@@ -135,68 +248,27 @@ void DijkstraZone::get_local_route(NetPoint* src, NetPoint* dst, RouteCreationAr
     }
   }
 
-  auto elm                   = route_cache_.emplace(src_id, std::vector<int>());
-  std::vector<int>& pred_arr = elm.first->second;
-
-  if (elm.second) { /* new element was inserted (not cached mode, or cache miss) */
-    int nr_nodes      = xbt_dynar_length(nodes);
-    std::vector<double> cost_arr(nr_nodes); /* link cost from src to other hosts */
-    pred_arr.resize(nr_nodes);              /* predecessors in path from src */
-    typedef std::pair<double, int> Qelt;
-    std::priority_queue<Qelt, std::vector<Qelt>, std::greater<Qelt>> pqueue;
-
-    /* initialize */
-    cost_arr[src_node_id] = 0.0;
-
-    for (int i = 0; i < nr_nodes; i++) {
-      if (i != src_node_id) {
-        cost_arr[i] = DBL_MAX;
-      }
-
-      pred_arr[i] = 0;
-
-      /* initialize priority queue */
-      pqueue.emplace(cost_arr[i], i);
-    }
-
-    /* apply dijkstra using the indexes from the graph's node array */
-    while (not pqueue.empty()) {
-      int v_id = pqueue.top().second;
-      pqueue.pop();
-      xbt_node_t v_node = xbt_dynar_get_as(nodes, v_id, xbt_node_t);
-      xbt_edge_t edge   = nullptr;
-      unsigned int cursor;
-
-      xbt_dynar_foreach (xbt_graph_node_get_outedges(v_node), cursor, edge) {
-        xbt_node_t u_node                  = xbt_graph_edge_get_target(edge);
-        GraphNodeData* data                = static_cast<GraphNodeData*>(xbt_graph_node_get_data(u_node));
-        int u_id                           = data->graph_id_;
-        RouteCreationArgs* tmp_e_route     = static_cast<RouteCreationArgs*>(xbt_graph_edge_get_data(edge));
-        int cost_v_u                       = tmp_e_route->link_list.size(); /* count of links, old model assume 1 */
-
-        if (cost_v_u + cost_arr[v_id] < cost_arr[u_id]) {
-          pred_arr[u_id] = v_id;
-          cost_arr[u_id] = cost_v_u + cost_arr[v_id];
-          pqueue.emplace(cost_arr[u_id], u_id);
-        }
-      }
-    }
+  const std::vector<int>* pred_arr = nullptr; /* not used when the paths were computed when sealing */
+  if (short_predecessor_table_.empty() && predecessor_table_.empty()) {
+    auto elm = route_cache_.emplace(src_id, std::vector<int>());
+    if (elm.second) /* new element was inserted (not cached mode, or cache miss) */
+      compute_predecessors(src_node_id, elm.first->second);
+    pred_arr = &elm.first->second;
   }
+  auto pred_of = [this, pred_arr, src_node_id](int v) {
+    return pred_arr ? (*pred_arr)[v] : get_predecessor(src_node_id, v);
+  };
 
   /* compose route path with links */
   NetPoint* gw_src   = nullptr;
   NetPoint* first_gw = nullptr;
 
-  for (int v = dst_node_id; v != src_node_id; v = pred_arr[v]) {
-    xbt_node_t node_pred_v = xbt_dynar_get_as(nodes, pred_arr[v], xbt_node_t);
-    xbt_node_t node_v      = xbt_dynar_get_as(nodes, v, xbt_node_t);
-    xbt_edge_t edge        = xbt_graph_get_edge(route_graph_, node_pred_v, node_v);
+  for (int v = dst_node_id; v != src_node_id; v = pred_of(v)) {
+    RouteCreationArgs* e_route = get_edge_route(pred_of(v), v);
 
-    if (edge == nullptr)
+    if (e_route == nullptr)
       THROWF(arg_error, 0, "No route from '%s' to '%s'", src->get_cname(), dst->get_cname());
 
-    RouteCreationArgs* e_route = static_cast<RouteCreationArgs*>(xbt_graph_edge_get_data(edge));
-
     NetPoint* prev_gw_src = gw_src;
     gw_src                = e_route->gw_src;
     NetPoint* gw_dst      = e_route->gw_dst;
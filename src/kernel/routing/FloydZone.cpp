@@ -5,18 +5,75 @@
 
 #include "simgrid/kernel/routing/FloydZone.hpp"
 #include "simgrid/kernel/routing/NetPoint.hpp"
+#include "src/include/xbt/parmap.hpp"
 #include "src/surf/network_interface.hpp"
+#include "src/surf/surf_interface.hpp"
 #include "src/surf/xml/platf_private.hpp"
 #include "surf/surf.hpp"
 
-#include <cfloat>
+#include <algorithm>
 #include <limits>
+#include <memory>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_route_floyd, surf, "Routing part of surf");
 
-#define TO_FLOYD_COST(i, j) (cost_table_)[(i) + (j)*table_size]
-#define TO_FLOYD_PRED(i, j) (predecessor_table_)[(i) + (j)*table_size]
-#define TO_FLOYD_LINK(i, j) (link_table_)[(i) + (j)*table_size]
+namespace {
+/* Cost (in links) of the paths that do not exist */
+constexpr uint32_t NO_PATH = std::numeric_limits<uint32_t>::max();
+/* The zones that are smaller than that are always sealed sequentially */
+constexpr unsigned int PARALLEL_SEAL_THRESHOLD = 256;
+/* Amount of destinations handled at once by a thread */
+constexpr unsigned int COLUMNS_PER_BLOCK = 64;
+
+/* Floyd-Warshall algorithm, on tables stored column by column (the cell of src to dst is at src + dst * size).
+ *
+ * The intermediate netpoints are considered in order, exactly as in the textbook version, so that the paths of same
+ * cost are chosen as they always were. For each of them, the paths toward each destination (i.e., each column) are
+ * relaxed independently: the paths from or toward the intermediate netpoint c cannot get shorter through c, so the
+ * column of c and the row of c are only read during that step. This lets the columns be split in blocks given to
+ * the threads of --cfg=network/routing-threads, and makes the inner loop work on contiguous memory.
+ */
+template <typename Pred>
+void compute_shortest_paths(unsigned int size, std::vector<uint32_t>& cost, std::vector<Pred>& pred)
+{
+  std::vector<unsigned int> blocks;
+  for (unsigned int first = 0; first < size; first += COLUMNS_PER_BLOCK)
+    blocks.push_back(first);
+
+  std::unique_ptr<simgrid::xbt::Parmap<unsigned int>> parmap;
+  if (sg_routing_threads > 1 && size >= PARALLEL_SEAL_THRESHOLD)
+    parmap.reset(new simgrid::xbt::Parmap<unsigned int>(sg_routing_threads, XBT_PARMAP_DEFAULT));
+
+  for (unsigned int c = 0; c < size; c++) {
+    const uint32_t* to_c = &cost[static_cast<size_t>(c) * size];
+    auto relax_block     = [size, c, to_c, &cost, &pred](unsigned int first) {
+      unsigned int last = std::min(first + COLUMNS_PER_BLOCK, size);
+      for (unsigned int b = first; b < last; b++) {
+        size_t column   = static_cast<size_t>(b) * size;
+        uint32_t c_to_b = cost[c + column];
+        if (b == c || c_to_b == NO_PATH)
+          continue;
+        Pred pred_c_to_b = pred[c + column];
+        uint32_t* to_b   = &cost[column];
+        Pred* pred_to_b  = &pred[column];
+        for (unsigned int a = 0; a < size; a++) { // Written without any branch, so that it gets vectorized
+          uint32_t current = to_b[a];
+          Pred current_pred = pred_to_b[a];
+          uint32_t via_c   = to_c[a] + c_to_b;
+          bool shorter     = (to_c[a] != NO_PATH) & (via_c < current);
+          to_b[a]          = shorter ? via_c : current;
+          pred_to_b[a]     = shorter ? pred_c_to_b : current_pred;
+        }
+      }
+    };
+    if (parmap)
+      parmap->apply(relax_block, blocks);
+    else
+      for (unsigned int first : blocks)
+        relax_block(first);
+  }
+}
+} // namespace
 
 namespace simgrid {
 namespace kernel {
@@ -25,40 +82,37 @@ namespace routing {
 FloydZone::FloydZone(NetZoneImpl* father, const std::string& name, resource::NetworkModel* netmodel)
     : RoutedZone(father, name, netmodel)
 {
-  predecessor_table_ = nullptr;
-  cost_table_        = nullptr;
-  link_table_        = nullptr;
 }
 
 FloydZone::~FloydZone()
 {
-  if (link_table_ == nullptr) // Dealing with a parse error in the file?
-    return;
-  unsigned int table_size = get_table_size();
-  /* Delete link_table */
-  for (unsigned int i = 0; i < table_size; i++)
-    for (unsigned int j = 0; j < table_size; j++)
-      delete TO_FLOYD_LINK(i, j);
-  delete[] link_table_;
-
-  delete[] predecessor_table_;
-  delete[] cost_table_;
+  for (auto const& elm : link_table_)
+    delete elm.second;
 }
 
-void FloydZone::get_local_route(NetPoint* src, NetPoint* dst, RouteCreationArgs* route, double* lat)
+int FloydZone::get_predecessor(unsigned int src, unsigned int dst)
 {
-  unsigned int table_size = get_table_size();
+  size_t index = src + static_cast<size_t>(dst) * get_table_size();
+  if (not short_predecessor_table_.empty()) {
+    uint16_t pred = short_predecessor_table_[index];
+    return pred == std::numeric_limits<uint16_t>::max() ? -1 : pred;
+  }
+  uint32_t pred = predecessor_table_[index];
+  return pred == std::numeric_limits<uint32_t>::max() ? -1 : static_cast<int>(pred);
+}
 
+void FloydZone::get_local_route(NetPoint* src, NetPoint* dst, RouteCreationArgs* route, double* lat)
+{
   get_route_check_params(src, dst);
 
   /* create a result route */
   std::vector<RouteCreationArgs*> route_stack;
   unsigned int cur = dst->id();
   do {
-    int pred = TO_FLOYD_PRED(src->id(), cur);
+    int pred = get_predecessor(src->id(), cur);
     if (pred == -1)
       THROWF(arg_error, 0, "No route from '%s' to '%s'", src->get_cname(), dst->get_cname());
-    route_stack.push_back(TO_FLOYD_LINK(pred, cur));
+    route_stack.push_back(link_table_.at({pred, cur}));
     cur = pred;
   } while (cur != src->id());
 
@@ -89,49 +143,29 @@ void FloydZone::get_local_route(NetPoint* src, NetPoint* dst, RouteCreationArgs*
 void FloydZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoint* gw_dst,
                           std::vector<resource::LinkImpl*>& link_list, bool symmetrical)
 {
-  /* set the size of table routing */
-  unsigned int table_size = get_table_size();
-
   add_route_check_params(src, dst, gw_src, gw_dst, link_list, symmetrical);
 
-  if (not link_table_) {
-    /* Create Cost, Predecessor and Link tables */
-    cost_table_        = new double[table_size * table_size];             /* link cost from host to host */
-    predecessor_table_ = new int[table_size * table_size];                /* predecessor host numbers */
-    link_table_        = new RouteCreationArgs*[table_size * table_size]; /* actual link between src and dst */
-
-    /* Initialize costs and predecessors */
-    for (unsigned int i = 0; i < table_size; i++)
-      for (unsigned int j = 0; j < table_size; j++) {
-        TO_FLOYD_COST(i, j) = DBL_MAX;
-        TO_FLOYD_PRED(i, j) = -1;
-        TO_FLOYD_LINK(i, j) = nullptr;
-      }
-  }
-
   /* Check that the route does not already exist */
   if (gw_dst) // netzone route (to adapt the error message, if any)
-    xbt_assert(nullptr == TO_FLOYD_LINK(src->id(), dst->id()),
+    xbt_assert(link_table_.find({src->id(), dst->id()}) == link_table_.end(),
                "The route between %s@%s and %s@%s already exists (Rq: routes are symmetrical by default).",
                src->get_cname(), gw_src->get_cname(), dst->get_cname(), gw_dst->get_cname());
   else
-    xbt_assert(nullptr == TO_FLOYD_LINK(src->id(), dst->id()),
+    xbt_assert(link_table_.find({src->id(), dst->id()}) == link_table_.end(),
                "The route between %s and %s already exists (Rq: routes are symmetrical by default).", src->get_cname(),
                dst->get_cname());
 
-  TO_FLOYD_LINK(src->id(), dst->id()) =
+  link_table_[{src->id(), dst->id()}] =
       new_extended_route(hierarchy_, src, dst, gw_src, gw_dst, link_list, symmetrical, 1);
-  TO_FLOYD_PRED(src->id(), dst->id()) = src->id();
-  TO_FLOYD_COST(src->id(), dst->id()) = (TO_FLOYD_LINK(src->id(), dst->id()))->link_list.size();
 
   if (symmetrical == true) {
     if (gw_dst) // netzone route (to adapt the error message, if any)
       xbt_assert(
-          nullptr == TO_FLOYD_LINK(dst->id(), src->id()),
+          link_table_.find({dst->id(), src->id()}) == link_table_.end(),
           "The route between %s@%s and %s@%s already exists. You should not declare the reverse path as symmetrical.",
           dst->get_cname(), gw_dst->get_cname(), src->get_cname(), gw_src->get_cname());
     else
-      xbt_assert(nullptr == TO_FLOYD_LINK(dst->id(), src->id()),
+      xbt_assert(link_table_.find({dst->id(), src->id()}) == link_table_.end(),
                  "The route between %s and %s already exists. You should not declare the reverse path as symmetrical.",
                  dst->get_cname(), src->get_cname());
 
@@ -147,11 +181,8 @@ void FloydZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoi
       XBT_DEBUG("Load NetzoneRoute from \"%s(%s)\" to \"%s(%s)\"", dst->get_cname(), gw_src->get_cname(),
                 src->get_cname(), gw_dst->get_cname());
 
-    TO_FLOYD_LINK(dst->id(), src->id()) =
+    link_table_[{dst->id(), src->id()}] =
         new_extended_route(hierarchy_, src, dst, gw_src, gw_dst, link_list, symmetrical, 0);
-    TO_FLOYD_PRED(dst->id(), src->id()) = dst->id();
-    TO_FLOYD_COST(dst->id(), src->id()) =
-        (TO_FLOYD_LINK(dst->id(), src->id()))->link_list.size(); /* count of links, old model assume 1 */
   }
 }
 
@@ -160,47 +191,39 @@ void FloydZone::seal()
   /* set the size of table routing */
   unsigned int table_size = get_table_size();
 
-  if (not link_table_) {
-    /* Create Cost, Predecessor and Link tables */
-    cost_table_        = new double[table_size * table_size];             /* link cost from host to host */
-    predecessor_table_ = new int[table_size * table_size];                /* predecessor host numbers */
-    link_table_        = new RouteCreationArgs*[table_size * table_size]; /* actual link between src and dst */
-
-    /* Initialize costs and predecessors */
-    for (unsigned int i = 0; i < table_size; i++)
-      for (unsigned int j = 0; j < table_size; j++) {
-        TO_FLOYD_COST(i, j) = DBL_MAX;
-        TO_FLOYD_PRED(i, j) = -1;
-        TO_FLOYD_LINK(i, j) = nullptr;
-      }
-  }
-
   /* Add the loopback if needed */
   if (network_model_->loopback_ && hierarchy_ == RoutingMode::base) {
     for (unsigned int i = 0; i < table_size; i++) {
-      RouteCreationArgs* route = TO_FLOYD_LINK(i, i);
+      RouteCreationArgs*& route = link_table_[{i, i}];
       if (not route) {
         route = new RouteCreationArgs();
         route->link_list.push_back(network_model_->loopback_);
-        TO_FLOYD_LINK(i, i) = route;
-        TO_FLOYD_PRED(i, i) = i;
-        TO_FLOYD_COST(i, i) = 1;
       }
     }
   }
-  /* Calculate path costs */
-  for (unsigned int c = 0; c < table_size; c++) {
-    for (unsigned int a = 0; a < table_size; a++) {
-      for (unsigned int b = 0; b < table_size; b++) {
-        if (TO_FLOYD_COST(a, c) < DBL_MAX && TO_FLOYD_COST(c, b) < DBL_MAX &&
-            (fabs(TO_FLOYD_COST(a, b) - DBL_MAX) < std::numeric_limits<double>::epsilon() ||
-             (TO_FLOYD_COST(a, c) + TO_FLOYD_COST(c, b) < TO_FLOYD_COST(a, b)))) {
-          TO_FLOYD_COST(a, b) = TO_FLOYD_COST(a, c) + TO_FLOYD_COST(c, b);
-          TO_FLOYD_PRED(a, b) = TO_FLOYD_PRED(c, b);
-        }
-      }
-    }
+
+  /* Initialize costs (in amount of links, the old model assumed 1) and predecessors from the declared routes */
+  std::vector<uint32_t> cost_table(static_cast<size_t>(table_size) * table_size, NO_PATH);
+  if (table_size < std::numeric_limits<uint16_t>::max())
+    short_predecessor_table_.assign(cost_table.size(), std::numeric_limits<uint16_t>::max());
+  else
+    predecessor_table_.assign(cost_table.size(), std::numeric_limits<uint32_t>::max());
+
+  for (auto const& elm : link_table_) {
+    unsigned int src  = elm.first.first;
+    size_t index      = src + static_cast<size_t>(elm.first.second) * table_size;
+    cost_table[index] = elm.second->link_list.size();
+    if (predecessor_table_.empty())
+      short_predecessor_table_[index] = src;
+    else
+      predecessor_table_[index] = src;
   }
+
+  /* Calculate path costs */
+  if (predecessor_table_.empty())
+    compute_shortest_paths(table_size, cost_table, short_predecessor_table_);
+  else
+    compute_shortest_paths(table_size, cost_table, predecessor_table_);
 }
 }
 }
@@ -7,6 +7,8 @@
 #include "simgrid/kernel/routing/NetPoint.hpp"
 #include "simgrid/s4u/Engine.hpp"
 #include "simgrid/s4u/Host.hpp"
+#include "src/kernel/EngineImpl.hpp"
+#include "src/kernel/routing/RouteCache.hpp"
 #include "src/surf/cpu_interface.hpp"
 #include "src/surf/network_interface.hpp"
 #include "src/surf/xml/platf_private.hpp"
@@ -32,6 +34,10 @@ NetZoneImpl::NetZoneImpl(NetZoneImpl* father, const std::string& name, resource:
   xbt_assert(nullptr == simgrid::s4u::Engine::get_instance()->netpoint_by_name_or_null(get_name()),
              "Refusing to create a second NetZone called '%s'.", get_cname());
 
+  if (father != nullptr)
+    ancestors_ = father->ancestors_;
+  ancestors_.push_back(this);
+
   netpoint_ = new NetPoint(name_, NetPoint::Type::NetZone, father);
   XBT_DEBUG("NetZone '%s' created with the id '%u'", get_cname(), netpoint_->id());
 }
@@ -144,6 +150,8 @@ void NetZoneImpl::add_bypass_route(NetPoint* src, NetPoint* dst, NetPoint* gw_sr
                "The bypass route between %s and %s already exists.", src->get_cname(), dst->get_cname());
   }
 
+  clear_route_cache();
+
   /* Build a copy that will be stored in the dict */
   kernel::routing::BypassRoute* newRoute = new kernel::routing::BypassRoute(gw_src, gw_dst);
   for (auto const& link : link_list)
@@ -203,6 +211,29 @@ void NetZoneImpl::add_bypass_route(NetPoint* src, NetPoint* dst, NetPoint* gw_sr
  *                 dst
  *  @endverbatim
  */
+/* Depth of the first ancestors of src_zone and dst_zone that differ, or of the deepest of both zones if it is an ancestor
+ * of the other one. All the netzones above that depth are common to both chains of ancestors.
+ *
+ * This works because all SimGrid platform have a unique root element, and the chains of ancestors are computed when
+ * the netzones are created. It is a binary search on these chains, since their common part is a prefix of both.
+ */
+static unsigned int divergence_depth(const NetZoneImpl* src_zone, const NetZoneImpl* dst_zone)
+{
+  unsigned int limit = std::min(src_zone->get_depth(), dst_zone->get_depth());
+  if (src_zone->get_ancestor(limit) == dst_zone->get_ancestor(limit))
+    return limit;
+  unsigned int low  = 0;     // common ancestor
+  unsigned int high = limit; // different ancestors
+  while (high - low > 1) {
+    unsigned int middle = (low + high) / 2;
+    if (src_zone->get_ancestor(middle) == dst_zone->get_ancestor(middle))
+      low = middle;
+    else
+      high = middle;
+  }
+  return high;
+}
+
 static void find_common_ancestors(NetPoint* src, NetPoint* dst,
                                   /* OUT */ NetZoneImpl** common_ancestor, NetZoneImpl** src_ancestor,
                                   NetZoneImpl** dst_ancestor)
@@ -215,50 +246,21 @@ static void find_common_ancestors(NetPoint* src, NetPoint* dst,
     return;
   }
 
-  /* engage the full recursive search */
-
-  /* (1) find the path to root of src and dst*/
   NetZoneImpl* src_as = src->get_englobing_zone();
   NetZoneImpl* dst_as = dst->get_englobing_zone();
 
   xbt_assert(src_as, "Host %s must be in a netzone", src->get_cname());
   xbt_assert(dst_as, "Host %s must be in a netzone", dst->get_cname());
 
-  /* (2) find the path to the root routing component */
-  std::vector<NetZoneImpl*> path_src;
-  NetZoneImpl* current = src->get_englobing_zone();
-  while (current != nullptr) {
-    path_src.push_back(current);
-    current = static_cast<NetZoneImpl*>(current->get_father());
-  }
-  std::vector<NetZoneImpl*> path_dst;
-  current = dst->get_englobing_zone();
-  while (current != nullptr) {
-    path_dst.push_back(current);
-    current = static_cast<NetZoneImpl*>(current->get_father());
-  }
+  /* Find where the chains of ancestors of src and dst differ (or where the shortest one ends) */
+  unsigned int depth = divergence_depth(src_as, dst_as);
 
-  /* (3) find the common father.
-   * Before that, index_src and index_dst may be different, they both point to nullptr in path_src/path_dst
-   * So we move them down simultaneously as long as they point to the same content.
-   *
-   * This works because all SimGrid platform have a unique root element (that is the last element of both paths).
-   */
-  NetZoneImpl* father = nullptr; // the netzone we dropped on the previous loop iteration
-  while (path_src.size() > 1 && path_dst.size() > 1 &&
-         path_src.at(path_src.size() - 1) == path_dst.at(path_dst.size() - 1)) {
-    father = path_src.at(path_src.size() - 1);
-    path_src.pop_back();
-    path_dst.pop_back();
-  }
-
-  /* (4) we found the difference at least. Finalize the returned values */
-  *src_ancestor = path_src.at(path_src.size() - 1); /* the first different father of src */
-  *dst_ancestor = path_dst.at(path_dst.size() - 1); /* the first different father of dst */
-  if (*src_ancestor == *dst_ancestor) {             // src is the ancestor of dst, or the contrary
+  *src_ancestor = src_as->get_ancestor(depth); /* the first different father of src */
+  *dst_ancestor = dst_as->get_ancestor(depth); /* the first different father of dst */
+  if (*src_ancestor == *dst_ancestor) {        // src is the ancestor of dst, or the contrary
     *common_ancestor = *src_ancestor;
   } else {
-    *common_ancestor = father;
+    *common_ancestor = src_as->get_ancestor(depth - 1);
   }
 }
 
@@ -288,30 +290,17 @@ bool NetZoneImpl::get_bypass_route(routing::NetPoint* src, routing::NetPoint* ds
 
   /* Engage recursive search */
 
-  /* (1) find the path to the root routing component */
-  std::vector<NetZoneImpl*> path_src;
-  NetZoneImpl* current = src->get_englobing_zone();
-  while (current != nullptr) {
-    path_src.push_back(static_cast<NetZoneImpl*>(current));
-    current = current->father_;
-  }
-
-  std::vector<NetZoneImpl*> path_dst;
-  current = dst->get_englobing_zone();
-  while (current != nullptr) {
-    path_dst.push_back(static_cast<NetZoneImpl*>(current));
-    current = current->father_;
-  }
-
-  /* (2) find the common father */
-  while (path_src.size() > 1 && path_dst.size() > 1 &&
-         path_src.at(path_src.size() - 1) == path_dst.at(path_dst.size() - 1)) {
-    path_src.pop_back();
-    path_dst.pop_back();
-  }
+  /* (1) find where the paths to the root routing component of src and dst differ.
+   * The path of src is made of the netzones from its englobing zone (at index 0) up to that point (at max_index_src),
+   * and similarly for dst. */
+  NetZoneImpl* src_zone = src->get_englobing_zone();
+  NetZoneImpl* dst_zone = dst->get_englobing_zone();
+  unsigned int depth    = divergence_depth(src_zone, dst_zone);
 
-  int max_index_src = path_src.size() - 1;
-  int max_index_dst = path_dst.size() - 1;
+  int max_index_src = src_zone->get_depth() - depth;
+  int max_index_dst = dst_zone->get_depth() - depth;
+  auto path_src     = [src_zone](int index) { return src_zone->get_ancestor(src_zone->get_depth() - index); };
+  auto path_dst     = [dst_zone](int index) { return dst_zone->get_ancestor(dst_zone->get_depth() - index); };
 
   int max_index = std::max(max_index_src, max_index_dst);
 
@@ -321,7 +310,7 @@ bool NetZoneImpl::get_bypass_route(routing::NetPoint* src, routing::NetPoint* ds
   for (int max = 0; max <= max_index; max++) {
     for (int i = 0; i < max; i++) {
       if (i <= max_index_src && max <= max_index_dst) {
-        key = {path_src.at(i)->netpoint_, path_dst.at(max)->netpoint_};
+        key = {path_src(i)->netpoint_, path_dst(max)->netpoint_};
         auto bpr = bypass_routes_.find(key);
         if (bpr != bypass_routes_.end()) {
           bypassedRoute = bpr->second;
@@ -329,7 +318,7 @@ bool NetZoneImpl::get_bypass_route(routing::NetPoint* src, routing::NetPoint* ds
         }
       }
       if (max <= max_index_src && i <= max_index_dst) {
-        key = {path_src.at(max)->netpoint_, path_dst.at(i)->netpoint_};
+        key = {path_src(max)->netpoint_, path_dst(i)->netpoint_};
         auto bpr = bypass_routes_.find(key);
         if (bpr != bypass_routes_.end()) {
           bypassedRoute = bpr->second;
@@ -342,7 +331,7 @@ bool NetZoneImpl::get_bypass_route(routing::NetPoint* src, routing::NetPoint* ds
       break;
 
     if (max <= max_index_src && max <= max_index_dst) {
-      key = {path_src.at(max)->netpoint_, path_dst.at(max)->netpoint_};
+      key = {path_src(max)->netpoint_, path_dst(max)->netpoint_};
       auto bpr = bypass_routes_.find(key);
       if (bpr != bypass_routes_.end()) {
         bypassedRoute = bpr->second;
@@ -373,6 +362,47 @@ bool NetZoneImpl::get_bypass_route(routing::NetPoint* src, routing::NetPoint* ds
 
 void NetZoneImpl::get_global_route(NetPoint* src, NetPoint* dst,
                                    /* OUT */ std::vector<resource::LinkImpl*>& links, double* latency)
+{
+  RouteCache& cache = s4u::Engine::get_instance()->pimpl->route_cache_;
+  if (not cache.is_enabled()) {
+    compute_global_route(src, dst, links, latency);
+    return;
+  }
+
+  const RouteCache::Route* cached = cache.get(src, dst);
+  if (cached != nullptr && cached->replayable) {
+    for (resource::LinkImpl* const& link : cached->links) {
+      links.push_back(link);
+      if (latency)
+        *latency += link->get_latency();
+    }
+    return;
+  }
+  if (cached != nullptr) {
+    compute_global_route(src, dst, links, latency);
+    return;
+  }
+
+  /* Compute the route as usual, and check whether the links alone are enough to get the same latency afterward */
+  size_t first_link   = links.size();
+  double own_latency  = 0.0;
+  double* accumulator = latency ? latency : &own_latency;
+  double replayed     = *accumulator;
+  compute_global_route(src, dst, links, accumulator);
+  for (auto link = links.begin() + first_link; link != links.end(); ++link)
+    replayed += (*link)->get_latency();
+  cache.put(src, dst,
+            {std::vector<resource::LinkImpl*>(links.begin() + first_link, links.end()), replayed == *accumulator});
+}
+
+void NetZoneImpl::clear_route_cache()
+{
+  if (s4u::Engine::is_initialized())
+    s4u::Engine::get_instance()->pimpl->route_cache_.clear();
+}
+
+void NetZoneImpl::compute_global_route(NetPoint* src, NetPoint* dst,
+                                       /* OUT */ std::vector<resource::LinkImpl*>& links, double* latency)
 {
   RouteCreationArgs route;
 
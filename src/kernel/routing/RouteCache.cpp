@@ -0,0 +1,59 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/kernel/routing/RouteCache.hpp"
+#include "simgrid/sg_config.hpp"
+
+XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(surf_route);
+
+static simgrid::config::Flag<int> cfg_route_cache_size{
+    "network/route-cache", "Amount of routes between netpoints that are kept in cache (0 to disable the cache)", 1024,
+    [](int value) { xbt_assert(value >= 0, "The size of the route cache cannot be negative"); }};
+
+namespace simgrid {
+namespace kernel {
+namespace routing {
+
+bool RouteCache::is_enabled() const
+{
+  return cfg_route_cache_size > 0;
+}
+
+const RouteCache::Route* RouteCache::get(NetPoint* src, NetPoint* dst)
+{
+  auto found = index_.find({src, dst});
+  if (found == index_.end()) {
+    misses_++;
+    return nullptr;
+  }
+  if (not found->second->second.replayable) {
+    misses_++;
+    return &found->second->second;
+  }
+  hits_++;
+  routes_.splice(routes_.begin(), routes_, found->second);
+  return &found->second->second;
+}
+
+void RouteCache::put(NetPoint* src, NetPoint* dst, Route&& route)
+{
+  routes_.emplace_front(Key(src, dst), std::move(route));
+  index_[{src, dst}] = routes_.begin();
+  while (routes_.size() > static_cast<size_t>(cfg_route_cache_size)) {
+    index_.erase(routes_.back().first);
+    routes_.pop_back();
+  }
+}
+
+void RouteCache::clear()
+{
+  if (not routes_.empty())
+    XBT_DEBUG("Platform modified: clear the cache of %zu routes", routes_.size());
+  routes_.clear();
+  index_.clear();
+}
+} // namespace routing
+} // namespace kernel
+} // namespace simgrid
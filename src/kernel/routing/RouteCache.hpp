@@ -0,0 +1,63 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_ROUTING_ROUTECACHE_HPP
+#define SIMGRID_ROUTING_ROUTECACHE_HPP
+
+#include <simgrid/forward.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace simgrid {
+namespace kernel {
+namespace routing {
+
+/** @brief Bounded cache of the routes computed by NetZoneImpl::get_global_route()
+ *
+ * The least recently used routes are evicted once the cache is full. Its size is given by --cfg=network/route-cache
+ * (0 disables the cache). Only the links are stored: the latency of a route is summed again from the current latency
+ * of its links when it is retrieved, so that latency profiles are taken into account.
+ *
+ * The cache is cleared whenever the platform changes (netpoints, routes or links are created or destroyed).
+ */
+class RouteCache {
+public:
+  struct Route {
+    std::vector<resource::LinkImpl*> links;
+    /* Whether adding the latency of each link gives the latency of the route. When it does not (as in Vivaldi), the
+     * route is computed again each time, but it is still cached to avoid checking that every time. */
+    bool replayable;
+  };
+
+  RouteCache() = default;
+  RouteCache(const RouteCache&) = delete;
+  RouteCache& operator=(const RouteCache&) = delete;
+
+  bool is_enabled() const;
+  /** Returns the route from src to dst (making it the most recently used one), or nullptr if it is not cached */
+  const Route* get(NetPoint* src, NetPoint* dst);
+  void put(NetPoint* src, NetPoint* dst, Route&& route);
+  void clear();
+
+  unsigned long get_hits() const { return hits_; }
+  unsigned long get_misses() const { return misses_; }
+
+private:
+  typedef std::pair<NetPoint*, NetPoint*> Key;
+  std::list<std::pair<Key, Route>> routes_; // the most recently used one first
+  std::unordered_map<Key, std::list<std::pair<Key, Route>>::iterator, boost::hash<Key>> index_;
+  unsigned long hits_   = 0;
+  unsigned long misses_ = 0;
+};
+} // namespace routing
+} // namespace kernel
+} // namespace simgrid
+
+#endif /* SIMGRID_ROUTING_ROUTECACHE_HPP */
@@ -10,10 +10,13 @@
 #include "simgrid/kernel/routing/NetPoint.hpp"
 #include "simgrid/kernel/routing/RoutedZone.hpp"
 #include "src/surf/network_interface.hpp"
+#include "src/surf/surf_interface.hpp"
 #include "src/surf/xml/platf_private.hpp"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_routing_generic, surf_route, "Generic implementation of the surf routing");
 
+int sg_routing_threads = 1; /* Change this with --cfg=network/routing-threads:VALUE */
+
 /* ***************************************************************** */
 /* *********************** GENERIC METHODS ************************* */
 
@@ -10,6 +10,7 @@
 #include "simgrid/s4u/Host.hpp"
 #include "simgrid/s4u/VirtualMachine.hpp"
 #include "src/kernel/activity/ExecImpl.hpp"
+#include "src/kernel/context/ContextStackless.hpp"
 #include "src/simix/smx_private.hpp"
 #include "src/surf/HostImpl.hpp"
 
@@ -61,6 +62,15 @@ ActorPtr Actor::create(const std::string& name, s4u::Host* host, const std::func
   return actor->iface();
 }
 
+ActorPtr Actor::create_stackless(const std::string& name, s4u::Host* host, const std::function<void()>& code)
+{
+  smx_actor_t self = SIMIX_process_self();
+  kernel::actor::ActorImpl* actor =
+      simix::simcall([self, &name, host, &code] { return self->init(name, host)->start(code, true); });
+
+  return actor->iface();
+}
+
 ActorPtr Actor::create(const std::string& name, s4u::Host* host, const std::string& function,
                        std::vector<std::string> args)
 {
@@ -284,6 +294,20 @@ void sleep_for(double duration)
   }
 }
 
+void await_for(double duration)
+{
+  kernel::context::StacklessContext* context = kernel::context::StacklessContext::current();
+  if (duration > 0) {
+    kernel::actor::ActorImpl* actor = SIMIX_process_self();
+    Actor::on_sleep(*actor->ciface());
+    context->await([actor] { Actor::on_wake_up(*actor->ciface()); });
+    simcall_process_sleep(duration);
+  } else {
+    context->await(nullptr);
+    simix::simcall([] { /* do nothing*/ });
+  }
+}
+
 void yield()
 {
   simix::simcall([] { /* do nothing*/ });
@@ -3,6 +3,9 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include "src/include/xbt/slab.hpp"
+#include "src/kernel/context/ContextStackless.hpp"
+#include "src/mc/mc_replay.hpp"
 #include "src/msg/msg_private.hpp"
 #include "xbt/log.h"
 
@@ -30,6 +33,16 @@ Comm::~Comm()
   }
 }
 
+void* Comm::operator new(size_t size)
+{
+  return xbt::Pooled<Comm>::operator new(size);
+}
+
+void Comm::operator delete(void* ptr, size_t size)
+{
+  xbt::Pooled<Comm>::operator delete(ptr, size);
+}
+
 int Comm::wait_any_for(std::vector<CommPtr>* comms, double timeout)
 {
   std::unique_ptr<kernel::activity::CommImpl* []> rcomms(new kernel::activity::CommImpl*[comms->size()]);
@@ -81,6 +94,12 @@ CommPtr Comm::set_src_data(void* buff, size_t size)
   src_buff_size_ = size;
   return this;
 }
+CommPtr Comm::set_src_data_moved(void* buff, size_t size)
+{
+  set_src_data(buff, size);
+  copy_data_function_ = &SIMIX_comm_move_buffer_callback;
+  return this;
+}
 CommPtr Comm::set_dst_data(void** buff)
 {
   xbt_assert(state_ == State::INITED, "You cannot use %s() once your communication started (not implemented)",
@@ -135,6 +154,46 @@ Comm* Comm::start()
   return this;
 }
 
+void Comm::start_all(const std::vector<CommPtr>& comms)
+{
+  if (MC_is_active() || MC_record_replay_is_active()) { // The model checker must see each communication start
+    for (CommPtr const& comm : comms)
+      comm->start();
+    return;
+  }
+
+  smx_actor_t issuer = SIMIX_process_self();
+  std::vector<std::function<void()>> starts;
+  starts.reserve(comms.size());
+  for (CommPtr const& comm : comms) {
+    Comm* c = comm.get();
+    xbt_assert(c->state_ == State::INITED, "You cannot use %s() once your communication started (not implemented)",
+               __FUNCTION__);
+    if (c->src_buff_ != nullptr) { // Sender side
+      on_sender_start(*Actor::self());
+      starts.emplace_back([issuer, c] {
+        c->pimpl_ = simcall_HANDLER_comm_isend(&issuer->simcall, c->sender_, c->mailbox_->get_impl(), c->remains_,
+                                               c->rate_, static_cast<unsigned char*>(c->src_buff_), c->src_buff_size_,
+                                               c->match_fun_, c->clean_fun_, c->copy_data_function_, c->user_data_,
+                                               c->detached_);
+      });
+    } else if (c->dst_buff_ != nullptr) { // Receiver side
+      xbt_assert(not c->detached_, "Receive cannot be detached");
+      on_receiver_start(*Actor::self());
+      starts.emplace_back([issuer, c] {
+        c->pimpl_ = simcall_HANDLER_comm_irecv(&issuer->simcall, c->receiver_, c->mailbox_->get_impl(),
+                                               static_cast<unsigned char*>(c->dst_buff_), &c->dst_buff_size_,
+                                               c->match_fun_, c->copy_data_function_, c->user_data_, c->rate_);
+      });
+    } else {
+      xbt_die("Cannot start a communication before specifying whether we are the sender or the receiver");
+    }
+  }
+  simcall_run_kernel_all(starts);
+  for (CommPtr const& comm : comms)
+    comm->state_ = State::STARTED;
+}
+
 /** @brief Block the calling actor until the communication is finished */
 Comm* Comm::wait()
 {
@@ -181,6 +240,36 @@ Comm* Comm::wait_for(double timeout)
   }
   return this;
 }
+void Comm::await()
+{
+  kernel::context::StacklessContext* context = kernel::context::StacklessContext::current();
+  if (state_ == State::INITED)
+    start();
+
+  switch (state_) {
+    case State::FINISHED:
+      context->await(nullptr);
+      simix::simcall([] { /* do nothing*/ });
+      break;
+
+    case State::STARTED: {
+      CommPtr self(this);
+      context->await([self] {
+        self->state_ = State::FINISHED;
+        on_completion(*Actor::self());
+      });
+      simcall_comm_wait(pimpl_, -1);
+      break;
+    }
+
+    case State::CANCELED:
+      throw CancelException(XBT_THROW_POINT, "Communication canceled");
+
+    default:
+      THROW_IMPOSSIBLE;
+  }
+}
+
 int Comm::test_any(std::vector<CommPtr>* comms)
 {
   std::unique_ptr<kernel::activity::CommImpl* []> rcomms(new kernel::activity::CommImpl*[comms->size()]);
@@ -348,11 +348,22 @@ std::vector<kernel::routing::NetPoint*> Engine::get_all_netpoints()
   return res;
 }
 
+unsigned long Engine::get_route_cache_hits()
+{
+  return pimpl->route_cache_.get_hits();
+}
+
+unsigned long Engine::get_route_cache_misses()
+{
+  return pimpl->route_cache_.get_misses();
+}
+
 /** @brief Register a new netpoint to the system */
 void Engine::netpoint_register(kernel::routing::NetPoint* point)
 {
   // simgrid::simix::simcall([&]{ FIXME: this segfaults in set_thread
   pimpl->netpoints_[point->get_name()] = point;
+  pimpl->route_cache_.clear();
   // });
 }
 
@@ -361,6 +372,7 @@ void Engine::netpoint_unregister(kernel::routing::NetPoint* point)
 {
   simix::simcall([this, point] {
     pimpl->netpoints_.erase(point->get_name());
+    pimpl->route_cache_.clear();
     delete point;
   });
 }
@@ -6,6 +6,7 @@
 #include "simgrid/s4u/Actor.hpp"
 #include "simgrid/s4u/Exec.hpp"
 #include "src/kernel/activity/ExecImpl.hpp"
+#include "src/kernel/context/ContextStackless.hpp"
 #include "xbt/log.h"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(s4u_exec, s4u_activity, "S4U asynchronous executions");
@@ -48,6 +49,19 @@ Exec* Exec::wait()
   return this;
 }
 
+void Exec::await()
+{
+  kernel::context::StacklessContext* context = kernel::context::StacklessContext::current();
+  if (state_ == State::INITED)
+    start();
+  ExecPtr self(this);
+  context->await([self] {
+    self->state_ = State::FINISHED;
+    on_completion(*Actor::self());
+  });
+  simcall_execution_wait(pimpl_);
+}
+
 Exec* Exec::wait_for(double)
 {
   THROW_UNIMPLEMENTED;
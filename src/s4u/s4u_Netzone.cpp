@@ -85,6 +85,7 @@ void NetZone::add_route(kernel::routing::NetPoint* src, kernel::routing::NetPoin
                         std::vector<kernel::resource::LinkImpl*>& link_list, bool symmetrical)
 {
   pimpl_->add_route(src, dst, gw_src, gw_dst, link_list, symmetrical);
+  kernel::routing::NetZoneImpl::clear_route_cache();
 }
 void NetZone::add_bypass_route(kernel::routing::NetPoint* src, kernel::routing::NetPoint* dst,
                                kernel::routing::NetPoint* gw_src, kernel::routing::NetPoint* gw_dst,
@@ -15,6 +15,7 @@
 #include "src/surf/surf_interface.hpp"
 #include "surf/surf.hpp"
 #include "xbt/config.hpp"
+#include "xbt/mallocator.h"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_config, surf, "About the configuration of SimGrid");
 
@@ -203,9 +204,11 @@ static void _sg_cfg_cb_contexts_parallel_mode(const std::string& mode_name)
     SIMIX_context_set_parallel_mode(XBT_PARMAP_FUTEX);
   } else if (mode_name == "busy_wait") {
     SIMIX_context_set_parallel_mode(XBT_PARMAP_BUSY_WAIT);
+  } else if (mode_name == "work_stealing") {
+    SIMIX_context_set_parallel_mode(XBT_PARMAP_WORK_STEALING);
   } else {
     xbt_die("Command line setting of the parallel synchronization mode should "
-            "be one of \"posix\", \"futex\" or \"busy_wait\"");
+            "be one of \"posix\", \"futex\", \"busy_wait\" or \"work_stealing\"");
   }
 }
 
@@ -255,6 +258,13 @@ void sg_config_init(int *argc, char **argv)
   simgrid::config::bind_flag(sg_surf_precision, "surf/precision",
                              "Numerical precision used when updating simulation times (in seconds)");
 
+  simgrid::config::declare_flag<std::string>(
+      "surf/action-heap", "Implementation of the heap of actions used by the models (either 4-ary or pairing)", "4-ary",
+      [](std::string const& value) {
+        if (value != "4-ary" && value != "pairing")
+          xbt_die("Invalid action heap '%s'. Possible values: 4-ary, pairing", value.c_str());
+      });
+
   simgrid::config::bind_flag(sg_maxmin_precision, "maxmin/precision",
                              "Numerical precision used when computing resource sharing (in flops/sec or bytes/sec)");
 
@@ -262,6 +272,39 @@ void sg_config_init(int *argc, char **argv)
                              "Maximum number of concurrent variables in the maxmim system. Also limits the number of "
                              "processes on each host, at higher level. (default: -1 means no such limitation)");
 
+  simgrid::config::declare_flag<std::string>(
+      "maxmin/solver", "Implementation of the max-min solver used by the CPU, network and storage models (either "
+                       "default or array)",
+      "default", [](std::string const& value) {
+        if (value != "default" && value != "array")
+          xbt_die("Invalid max-min solver '%s'. Possible values: default, array", value.c_str());
+      });
+
+  simgrid::config::bind_flag(sg_maxmin_threads, "maxmin/threads",
+                             "Number of threads used by the array max-min solver to solve the independent parts of the "
+                             "system in parallel (default: 1, i.e. sequential)",
+                             [](int value) {
+                               if (value < 1)
+                                 xbt_die("maxmin/threads must be at least 1 (got %d)", value);
+                             });
+
+  simgrid::config::bind_flag(sg_maxmin_parallel_threshold, "maxmin/parallel-threshold",
+                             "Minimal number of active elements in the system for the array max-min solver to use its "
+                             "threads. Smaller systems are solved sequentially.");
+
+  simgrid::config::declare_flag<bool>("maxmin/incremental",
+                                      "Whether the array max-min solver should start from the previous solution, and "
+                                      "only solve again the part of the system that is affected by the changes",
+                                      false);
+
+  simgrid::config::bind_flag(sg_routing_threads, "network/routing-threads",
+                             "Number of threads used to compute the routing tables of the large netzones when they "
+                             "are sealed (default: 1, i.e. sequential)",
+                             [](int value) {
+                               if (value < 1)
+                                 xbt_die("network/routing-threads must be at least 1 (got %d)", value);
+                             });
+
   /* The parameters of network models */
 
   sg_latency_factor = 13.01; // comes from the default LV08 network model
@@ -317,7 +360,7 @@ void sg_config_init(int *argc, char **argv)
                                      &SIMIX_context_set_nthreads);
 
   simgrid::config::declare_flag<int>("contexts/parallel-threshold",
-                                     "Minimal number of user contexts to be run in parallel (raw contexts only)", 2,
+                                     "Minimal number of user contexts to be run in parallel (not with thread contexts)", 2,
                                      &SIMIX_context_set_parallel_threshold);
   simgrid::config::alias("contexts/parallel-threshold", {"contexts/parallel_threshold"});
 
@@ -328,7 +371,7 @@ void sg_config_init(int *argc, char **argv)
   std::string default_synchro_mode = "busy_wait";
 #endif
   simgrid::config::declare_flag<std::string>("contexts/synchro", "Synchronization mode to use when running contexts in "
-                                                                 "parallel (either futex, posix or busy_wait)",
+                                                                 "parallel (either futex, posix, busy_wait or work_stealing)",
                                              default_synchro_mode, &_sg_cfg_cb_contexts_parallel_mode);
 
   // For smpi/bw-factor and smpi/lat-factor
@@ -0,0 +1,140 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/simix/TimerWheel.hpp"
+#include "xbt/asserts.h"
+
+namespace simgrid {
+namespace simix {
+
+/** Index of the lowest bit set in a non-zero word */
+static int lowest_bit(uint64_t word)
+{
+  int bit = 0;
+  for (int width = 32; width > 0; width /= 2)
+    if ((word & ((uint64_t(1) << width) - 1)) == 0) {
+      word >>= width;
+      bit += width;
+    }
+  return bit;
+}
+
+TimerWheel::TimerWheel(double tick) : tick_(tick)
+{
+  xbt_assert(tick > 0, "The ticks of the timer wheel must last a positive duration");
+}
+
+uint64_t TimerWheel::tick_of(double date) const
+{
+  double tick = date / tick_;
+  if (not(tick > 0)) // also catches NaN
+    return 0;
+  if (tick >= 18446744073709551616.0) // 2^64
+    return UINT64_MAX;
+  return static_cast<uint64_t>(tick);
+}
+
+void TimerWheel::insert(Timer* timer)
+{
+  timer->wheel_seq_ = next_seq_++;
+  place(timer);
+  size_++;
+}
+
+void TimerWheel::remove(Timer* timer)
+{
+  if (timer->wheel_slot_ < 0) {
+    current_.erase(timer);
+  } else {
+    int index = timer->wheel_slot_;
+    if (timer->wheel_prev_)
+      timer->wheel_prev_->wheel_next_ = timer->wheel_next_;
+    else
+      heads_[index] = timer->wheel_next_;
+    if (timer->wheel_next_)
+      timer->wheel_next_->wheel_prev_ = timer->wheel_prev_;
+    if (heads_[index] == nullptr)
+      occupied_[index / slots] &= ~(uint64_t(1) << (index % slots));
+  }
+  size_--;
+}
+
+Timer* TimerWheel::top()
+{
+  while (current_.empty())
+    if (not advance())
+      return nullptr;
+  return *current_.begin();
+}
+
+Timer* TimerWheel::pop()
+{
+  Timer* timer = top();
+  xbt_assert(timer != nullptr, "No timer to pop");
+  current_.erase(current_.begin());
+  size_--;
+  return timer;
+}
+
+/** Puts the timer in the current set or in the slot of the first level where its tick differs from the cursor */
+void TimerWheel::place(Timer* timer)
+{
+  uint64_t tick = tick_of(timer->get_date());
+  if (tick <= cursor_) {
+    timer->wheel_slot_ = -1;
+    current_.insert(timer);
+    return;
+  }
+  int level = 0;
+  for (uint64_t diff = (tick ^ cursor_) >> slot_bits; diff != 0; diff >>= slot_bits)
+    level++;
+  link(timer, level, static_cast<int>((tick >> (level * slot_bits)) & (slots - 1)));
+}
+
+void TimerWheel::link(Timer* timer, int level, int slot)
+{
+  int index          = level * slots + slot;
+  timer->wheel_slot_ = index;
+  timer->wheel_prev_ = nullptr;
+  timer->wheel_next_ = heads_[index];
+  if (heads_[index])
+    heads_[index]->wheel_prev_ = timer;
+  heads_[index] = timer;
+  occupied_[level] |= uint64_t(1) << slot;
+}
+
+/** Moves the cursor to the beginning of the next non-empty slot and cascades its timers to the lower levels.
+ *
+ * Returns false if the wheel is empty.
+ */
+bool TimerWheel::advance()
+{
+  for (int level = 0; level < levels; level++) {
+    int shift      = level * slot_bits;
+    int digit      = static_cast<int>((cursor_ >> shift) & (slots - 1));
+    uint64_t later = digit + 1 < slots ? occupied_[level] & (~uint64_t(0) << (digit + 1)) : 0;
+    if (later == 0)
+      continue;
+
+    int slot = lowest_bit(later);
+    // The lower levels are empty: move to the first tick of that slot, keeping the higher digits of the cursor
+    uint64_t low_mask = shift + slot_bits >= 64 ? UINT64_MAX : (uint64_t(1) << (shift + slot_bits)) - 1;
+    cursor_           = (cursor_ & ~low_mask) | (uint64_t(slot) << shift);
+
+    int index     = level * slots + slot;
+    Timer* timer  = heads_[index];
+    heads_[index] = nullptr;
+    occupied_[level] &= ~(uint64_t(1) << slot);
+    while (timer != nullptr) {
+      Timer* next = timer->wheel_next_;
+      place(timer);
+      timer = next;
+    }
+    return true;
+  }
+  return false;
+}
+} // namespace simix
+} // namespace simgrid
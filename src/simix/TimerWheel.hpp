@@ -0,0 +1,72 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_SIMIX_TIMER_WHEEL_HPP
+#define SIMGRID_SIMIX_TIMER_WHEEL_HPP
+
+#include "simgrid/simix.hpp"
+
+#include <array>
+#include <cstdint>
+#include <set>
+
+namespace simgrid {
+namespace simix {
+
+/** @brief Hierarchical timing wheel holding the SIMIX timers (see simix/timers)
+ *
+ * The dates are cut in ticks of a given duration. Each level of the wheel has 64 slots, and a slot of level k covers
+ * 64^k ticks. A timer is linked in the slot of the first level where its tick differs from the cursor of the wheel,
+ * so inserting and cancelling a timer costs O(1). When the slots before a timer get empty, the cursor moves to it and
+ * the timers of its slot cascade to the lower levels, until they reach the tick of the cursor.
+ *
+ * The timers of the current tick are kept in an ordered set, so that they fire at their exact date, in the order of
+ * their dates, and in the order in which they were set when their dates are equal.
+ */
+class TimerWheel {
+public:
+  explicit TimerWheel(double tick);
+  TimerWheel(TimerWheel const&) = delete;
+  TimerWheel& operator=(TimerWheel const&) = delete;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  void insert(Timer* timer);
+  void remove(Timer* timer);
+  /** Returns the next timer to fire, or nullptr if there is none */
+  Timer* top();
+  /** Removes the next timer to fire (that must exist) from the wheel, and returns it */
+  Timer* pop();
+
+private:
+  static constexpr int slot_bits = 6;
+  static constexpr int slots     = 1 << slot_bits;
+  static constexpr int levels    = (64 + slot_bits - 1) / slot_bits;
+
+  struct Earlier {
+    bool operator()(const Timer* a, const Timer* b) const
+    {
+      return a->get_date() < b->get_date() || (a->get_date() == b->get_date() && a->wheel_seq_ < b->wheel_seq_);
+    }
+  };
+
+  uint64_t tick_of(double date) const;
+  void place(Timer* timer);
+  void link(Timer* timer, int level, int slot);
+  bool advance();
+
+  double tick_;
+  uint64_t cursor_   = 0;
+  uint64_t next_seq_ = 0;
+  size_t size_       = 0;
+  std::array<Timer*, levels * slots> heads_{};
+  std::array<uint64_t, levels> occupied_{}; // Bitmap of the non-empty slots of each level
+  std::set<Timer*, Earlier> current_;       // Timers whose tick is not after the cursor
+};
+} // namespace simix
+} // namespace simgrid
+
+#endif
@@ -323,6 +323,12 @@ void simcall_run_kernel(std::function<void()> const& code)
   simcall_BODY_run_kernel(&code);
 }
 
+void simcall_run_kernel_all(std::vector<std::function<void()>> const& codes)
+{
+  if (not codes.empty())
+    simcall_BODY_run_kernel_all(codes.data(), codes.size());
+}
+
 void simcall_run_blocking(std::function<void()> const& code)
 {
   simcall_BODY_run_blocking(&code);
@@ -4,16 +4,40 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "smx_private.hpp"
+#include "mc/mc.h"
+#include "src/kernel/activity/CommImpl.hpp"
+#include "src/kernel/activity/MailboxImpl.hpp"
+#include "src/kernel/activity/MutexImpl.hpp"
+#include "src/kernel/activity/SemaphoreImpl.hpp"
+#include "src/mc/mc_replay.hpp"
+#include "xbt/config.hpp"
+#include "xbt/parmap.hpp"
+
+#include <unordered_map>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_popping, simix,
                                 "Popping part of SIMIX (transmuting from user request into kernel handlers)");
 
+static simgrid::config::Flag<bool> cfg_parallel_simcalls{
+    "simix/parallel-simcalls",
+    "Whether to handle in parallel the simcalls touching distinct kernel objects, when the actors run in parallel",
+    false};
+
+/* While simcalls are handled in parallel, the actors to wake up are stored here instead of in actors_to_run */
+static thread_local std::vector<smx_actor_t>* deferred_answers = nullptr;
+
 void SIMIX_simcall_answer(smx_simcall_t simcall)
 {
   if (simcall->issuer != simix_global->maestro_process){
     XBT_DEBUG("Answer simcall %s (%d) issued by %s (%p)", SIMIX_simcall_name(simcall->call), (int)simcall->call,
               simcall->issuer->get_cname(), simcall->issuer);
     simcall->issuer->simcall.call = SIMCALL_NONE;
+    if (simcall->issuer->context_.get() == simgrid::kernel::context::Context::self())
+      return; // A stackless actor handling its own simcall: it is still running
+    if (deferred_answers != nullptr) {
+      deferred_answers->push_back(simcall->issuer);
+      return;
+    }
     xbt_assert(not XBT_LOG_ISENABLED(simix_popping, xbt_log_priority_debug) ||
                    std::find(begin(simix_global->actors_to_run), end(simix_global->actors_to_run), simcall->issuer) ==
                        end(simix_global->actors_to_run),
@@ -27,6 +51,12 @@ void SIMIX_run_kernel(std::function<void()> const* code)
   (*code)();
 }
 
+void SIMIX_run_kernel_all(std::function<void()> const* codes, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    codes[i]();
+}
+
 /** Kernel code for run_blocking
  *
  * The implementation looks a lot like SIMIX_run_kernel ^^
@@ -39,3 +69,211 @@ void SIMIX_run_blocking(std::function<void()> const* code)
 {
   (*code)();
 }
+
+namespace {
+/** @brief Handles the simcalls of a scheduling round, the ones touching distinct kernel objects in parallel.
+ *
+ * The simcalls are considered in the order in which they would be handled sequentially. The ones that only modify a
+ * kernel object (and their issuer) are grouped by object, until a simcall with wider effects is found (creating a surf
+ * action, waking up another actor, etc). The groups are then handled in parallel, each of them in order, and the actors
+ * that they answered are pushed to actors_to_run in the order of the simcalls. The simcall with wider effects is then
+ * handled alone by maestro. The result is thus exactly the same as when handling all the simcalls in order.
+ */
+class SimcallDispatcher {
+  /* Simcalls touching a given kernel object, and state of that object once they are handled (to check that the next
+   * ones can be handled in the same group) */
+  struct LocalObject {
+    std::vector<unsigned> simcalls;                      // indexes in batch_
+    bool locked                               = false;   // mutex
+    simgrid::kernel::actor::ActorImpl* owner = nullptr; // mutex
+    unsigned int value                        = 0;       // semaphore
+    bool has_sends                            = false;   // mailbox
+    bool has_receives                         = false;   // mailbox
+  };
+
+  std::vector<smx_simcall_t> batch_;
+  std::vector<std::vector<smx_actor_t>> answers_; // actors answered by each simcall of the batch
+  std::vector<LocalObject> objects_;
+  std::unordered_map<const void*, unsigned> object_index_;
+  std::unique_ptr<simgrid::xbt::Parmap<LocalObject*>> parmap_;
+
+  LocalObject* find_object(const void* object)
+  {
+    auto it = object_index_.find(object);
+    return it == object_index_.end() ? nullptr : &objects_[it->second];
+  }
+  LocalObject& add_simcall(const void* object, smx_simcall_t simcall);
+  bool batch_simcall(smx_simcall_t simcall);
+  void flush();
+
+public:
+  void handle(const std::vector<smx_actor_t>& actors);
+};
+
+/* All the mc_random simcalls share the same random engine, so they are grouped on this object */
+const char mc_random_engine = 0;
+
+SimcallDispatcher::LocalObject& SimcallDispatcher::add_simcall(const void* object, smx_simcall_t simcall)
+{
+  auto it = object_index_.emplace(object, objects_.size());
+  if (it.second)
+    objects_.emplace_back();
+  LocalObject& local = objects_[it.first->second];
+  local.simcalls.push_back(batch_.size());
+  batch_.push_back(simcall);
+  return local;
+}
+
+/** Adds the simcall to the current batch if it only touches one kernel object, and returns whether it did */
+bool SimcallDispatcher::batch_simcall(smx_simcall_t simcall)
+{
+  smx_actor_t issuer = simcall->issuer;
+  switch (simcall->call) {
+    case SIMCALL_MUTEX_LOCK:
+    case SIMCALL_MUTEX_TRYLOCK:
+    case SIMCALL_MUTEX_UNLOCK: {
+      smx_mutex_t mutex = simcall->call == SIMCALL_MUTEX_LOCK      ? simcall_mutex_lock__get__mutex(simcall)
+                          : simcall->call == SIMCALL_MUTEX_TRYLOCK ? simcall_mutex_trylock__get__mutex(simcall)
+                                                                   : simcall_mutex_unlock__get__mutex(simcall);
+      const LocalObject* local = find_object(mutex);
+      bool locked              = local ? local->locked : mutex->locked_;
+      smx_actor_t owner        = local ? local->owner : mutex->owner_;
+      if (simcall->call == SIMCALL_MUTEX_LOCK) {
+        if (locked) // would put the issuer to sleep, with a synchro on its host
+          return false;
+        owner = issuer;
+      } else if (simcall->call == SIMCALL_MUTEX_TRYLOCK) {
+        if (not locked)
+          owner = issuer;
+      } else {
+        if (not locked || owner != issuer || not mutex->sleeping_.empty()) // would fail or wake another actor up
+          return false;
+        owner = nullptr;
+      }
+      LocalObject& updated = add_simcall(mutex, simcall);
+      updated.locked       = owner != nullptr;
+      updated.owner        = owner;
+      return true;
+    }
+
+    case SIMCALL_SEM_ACQUIRE: {
+      smx_sem_t sem            = simcall_sem_acquire__get__sem(simcall);
+      const LocalObject* local = find_object(sem);
+      unsigned int value       = local ? local->value : sem->value_;
+      if (value == 0) // would put the issuer to sleep, with a synchro on its host
+        return false;
+      add_simcall(sem, simcall).value = value - 1;
+      return true;
+    }
+
+    case SIMCALL_COMM_ISEND:
+    case SIMCALL_COMM_IRECV: {
+      bool send            = simcall->call == SIMCALL_COMM_ISEND;
+      smx_mailbox_t mbox   = send ? simcall_comm_isend__get__mbox(simcall) : simcall_comm_irecv__get__mbox(simcall);
+      smx_actor_t actor    = send ? simcall_comm_isend__get__sender(simcall) : simcall_comm_irecv__get__receiver(simcall);
+      if (actor != issuer || mbox->permanent_receiver_ != nullptr)
+        return false;
+      const LocalObject* local = find_object(mbox);
+      bool has_sends           = local && local->has_sends;
+      bool has_receives        = local && local->has_receives;
+      if (local == nullptr) {
+        for (auto const& comm : mbox->comm_queue_) {
+          if (comm == nullptr) // hole left in an indexed mailbox
+            continue;
+          has_sends    = has_sends || comm->type_ == simgrid::kernel::activity::CommImpl::Type::SEND;
+          has_receives = has_receives || comm->type_ == simgrid::kernel::activity::CommImpl::Type::RECEIVE;
+        }
+      }
+      if (send ? has_receives : has_sends) // may match, and start the communication
+        return false;
+      LocalObject& updated = add_simcall(mbox, simcall);
+      updated.has_sends    = has_sends || send;
+      updated.has_receives = has_receives || not send;
+      return true;
+    }
+
+    case SIMCALL_MC_RANDOM:
+      add_simcall(&mc_random_engine, simcall);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/** Handles the simcalls of the current batch */
+void SimcallDispatcher::flush()
+{
+  if (batch_.empty())
+    return;
+
+  if (objects_.size() > 1 && batch_.size() >= static_cast<size_t>(SIMIX_context_get_parallel_threshold())) {
+    XBT_DEBUG("Handle %zu simcalls on %zu objects in parallel", batch_.size(), objects_.size());
+    if (parmap_ == nullptr)
+      parmap_.reset(
+          new simgrid::xbt::Parmap<LocalObject*>(SIMIX_context_get_nthreads(), SIMIX_context_get_parallel_mode()));
+    answers_.resize(batch_.size());
+    std::vector<LocalObject*> groups;
+    groups.reserve(objects_.size());
+    for (LocalObject& local : objects_)
+      groups.push_back(&local);
+    parmap_->apply(
+        [this](LocalObject* local) {
+          for (unsigned i : local->simcalls) {
+            deferred_answers = &answers_[i];
+            SIMIX_simcall_handle(batch_[i], 0);
+          }
+          deferred_answers = nullptr;
+        },
+        groups);
+    for (std::vector<smx_actor_t>& answered : answers_) {
+      simix_global->actors_to_run.insert(end(simix_global->actors_to_run), begin(answered), end(answered));
+      answered.clear();
+    }
+  } else {
+    for (smx_simcall_t simcall : batch_)
+      SIMIX_simcall_handle(simcall, 0);
+  }
+
+  batch_.clear();
+  objects_.clear();
+  object_index_.clear();
+}
+
+void SimcallDispatcher::handle(const std::vector<smx_actor_t>& actors)
+{
+  for (smx_actor_t const& actor : actors) {
+    smx_simcall_t simcall = &actor->simcall;
+    if (simcall->call == SIMCALL_NONE)
+      continue;
+    // The simcalls of dying actors are ignored anyway
+    if (not actor->context_->iwannadie && not batch_simcall(simcall)) {
+      flush();
+      SIMIX_simcall_handle(simcall, 0);
+    }
+  }
+  flush();
+}
+
+std::unique_ptr<SimcallDispatcher> simcall_dispatcher;
+} // namespace
+
+/** @brief Handles the simcalls issued by the given actors, in parallel when possible (see simix/parallel-simcalls) */
+void SIMIX_simcalls_handle(const std::vector<smx_actor_t>& actors)
+{
+  if (cfg_parallel_simcalls && SIMIX_context_is_parallel() && not MC_is_active() && not MC_record_replay_is_active()) {
+    if (simcall_dispatcher == nullptr)
+      simcall_dispatcher.reset(new SimcallDispatcher());
+    simcall_dispatcher->handle(actors);
+  } else {
+    for (smx_actor_t const& actor : actors)
+      if (actor->simcall.call != SIMCALL_NONE)
+        SIMIX_simcall_handle(&actor->simcall, 0);
+  }
+}
+
+/** @brief Stops the threads used to handle the simcalls in parallel */
+void SIMIX_simcalls_exit()
+{
+  simcall_dispatcher.reset();
+}
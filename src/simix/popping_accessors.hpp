@@ -1010,6 +1010,31 @@ static inline void simcall_run_kernel__set__code(smx_simcall_t simcall, std::fun
   simgrid::simix::marshal<std::function<void()> const*>(simcall->args[0], arg);
 }
 
+static inline std::function<void()> const* simcall_run_kernel_all__get__codes(smx_simcall_t simcall)
+{
+  return simgrid::simix::unmarshal<std::function<void()> const*>(simcall->args[0]);
+}
+static inline std::function<void()> const* simcall_run_kernel_all__getraw__codes(smx_simcall_t simcall)
+{
+  return simgrid::simix::unmarshal_raw<std::function<void()> const*>(simcall->args[0]);
+}
+static inline void simcall_run_kernel_all__set__codes(smx_simcall_t simcall, std::function<void()> const* arg)
+{
+  simgrid::simix::marshal<std::function<void()> const*>(simcall->args[0], arg);
+}
+static inline size_t simcall_run_kernel_all__get__codes_count(smx_simcall_t simcall)
+{
+  return simgrid::simix::unmarshal<size_t>(simcall->args[1]);
+}
+static inline size_t simcall_run_kernel_all__getraw__codes_count(smx_simcall_t simcall)
+{
+  return simgrid::simix::unmarshal_raw<size_t>(simcall->args[1]);
+}
+static inline void simcall_run_kernel_all__set__codes_count(smx_simcall_t simcall, size_t arg)
+{
+  simgrid::simix::marshal<size_t>(simcall->args[1], arg);
+}
+
 static inline std::function<void()> const* simcall_run_blocking__get__code(smx_simcall_t simcall)
 {
   return simgrid::simix::unmarshal<std::function<void()> const*>(simcall->args[0]);
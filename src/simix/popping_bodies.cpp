@@ -218,6 +218,13 @@ inline static void simcall_BODY_run_kernel(std::function<void()> const* code)
   return simcall<void, std::function<void()> const*>(SIMCALL_RUN_KERNEL, code);
 }
 
+inline static void simcall_BODY_run_kernel_all(std::function<void()> const* codes, size_t codes_count)
+{
+  if (0) /* Go to that function to follow the code flow through the simcall barrier */
+    SIMIX_run_kernel_all(codes, codes_count);
+  return simcall<void, std::function<void()> const*, size_t>(SIMCALL_RUN_KERNEL_ALL, codes, codes_count);
+}
+
 inline static void simcall_BODY_run_blocking(std::function<void()> const* code)
 {
   if (0) /* Go to that function to follow the code flow through the simcall barrier */
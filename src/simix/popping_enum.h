@@ -42,6 +42,7 @@ typedef enum {
   SIMCALL_IO_WAIT,
   SIMCALL_MC_RANDOM,
   SIMCALL_RUN_KERNEL,
+  SIMCALL_RUN_KERNEL_ALL,
   SIMCALL_RUN_BLOCKING,
   NUM_SIMCALLS
 } e_smx_simcall_t;
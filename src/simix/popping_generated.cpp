@@ -49,6 +49,7 @@ const char* simcall_names[] = {
     "SIMCALL_IO_WAIT",
     "SIMCALL_MC_RANDOM",
     "SIMCALL_RUN_KERNEL",
+    "SIMCALL_RUN_KERNEL_ALL",
     "SIMCALL_RUN_BLOCKING",
 };
 
@@ -194,6 +195,12 @@ case SIMCALL_RUN_KERNEL:
   SIMIX_simcall_answer(simcall);
   break;
 
+case SIMCALL_RUN_KERNEL_ALL:
+  SIMIX_run_kernel_all(simgrid::simix::unmarshal<std::function<void()> const*>(simcall->args[0]),
+                       simgrid::simix::unmarshal<size_t>(simcall->args[1]));
+  SIMIX_simcall_answer(simcall);
+  break;
+
 case SIMCALL_RUN_BLOCKING:
   SIMIX_run_blocking(simgrid::simix::unmarshal<std::function<void()> const*>(simcall->args[0]));
   break;
@@ -10,6 +10,7 @@
 #include "src/kernel/activity/ActivityImpl.hpp"
 
 #include <boost/intrusive_ptr.hpp>
+#include <vector>
 
 /********************************* Simcalls *********************************/
 XBT_PUBLIC_DATA const char* simcall_names[]; /* Name of each simcall */
@@ -58,8 +59,11 @@ struct s_smx_simcall {
 
 XBT_PRIVATE void SIMIX_simcall_answer(smx_simcall_t simcall);
 XBT_PRIVATE void SIMIX_simcall_handle(smx_simcall_t simcall, int value);
+XBT_PRIVATE void SIMIX_simcalls_handle(const std::vector<smx_actor_t>& actors);
+XBT_PRIVATE void SIMIX_simcalls_exit();
 XBT_PRIVATE const char* SIMIX_simcall_name(e_smx_simcall_t kind);
 XBT_PRIVATE void SIMIX_run_kernel(std::function<void()> const* code);
+XBT_PRIVATE void SIMIX_run_kernel_all(std::function<void()> const* codes, size_t count);
 XBT_PRIVATE void SIMIX_run_blocking(std::function<void()> const* code);
 
 /* Defines the marshal/unmarshal functions for each type of parameters.
@@ -204,7 +204,13 @@ def parse(fn):
                 t, n = match.groups()
                 t = t.strip()
                 n = n.strip()
-                sargs.append(Arg(n, t))
+                if n.endswith("[]"):
+                    # Vectored argument: passed as a pointer to its first element and its amount of elements
+                    n = n[:-2]
+                    sargs.append(Arg(n, t + "*"))
+                    sargs.append(Arg(n + "_count", "size_t"))
+                else:
+                    sargs.append(Arg(n, t))
         if ret == "void":
             ans = "Proc"
         else:
@@ -6,6 +6,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/internal_config.h"
+#include "src/kernel/context/ContextSwapped.hpp"
 #include "src/simix/smx_private.hpp"
 #include "xbt/config.hpp"
 
@@ -191,3 +192,28 @@ e_xbt_parmap_mode_t SIMIX_context_get_parallel_mode() {
 void SIMIX_context_set_parallel_mode(e_xbt_parmap_mode_t mode) {
   smx_parallel_synchronization_mode = mode;
 }
+
+/**
+ * @brief Returns the number of scheduling rounds where the user contexts were run sequentially or in parallel.
+ *
+ * These statistics are only gathered when the user contexts may run in parallel, with the raw, boost or ucontext
+ * factories. They show which rounds were found large enough to be run in parallel (see contexts/parallel-threshold and
+ * contexts/parallel-adaptive).
+ *
+ * @param parallel whether to count the parallel rounds (or the sequential ones)
+ */
+unsigned long SIMIX_context_get_rounds(int parallel)
+{
+  auto* factory = dynamic_cast<simgrid::kernel::context::SwappedContextFactory*>(simix_global->context_factory);
+  return factory ? factory->get_rounds(parallel) : 0;
+}
+
+/**
+ * @brief Returns the wall-clock time spent in the scheduling rounds run sequentially or in parallel.
+ * @param parallel whether to sum the duration of the parallel rounds (or of the sequential ones)
+ */
+double SIMIX_context_get_rounds_duration(int parallel)
+{
+  auto* factory = dynamic_cast<simgrid::kernel::context::SwappedContextFactory*>(simix_global->context_factory);
+  return factory ? factory->get_rounds_duration(parallel) : 0.0;
+}
@@ -9,6 +9,7 @@
 #include "src/smpi/include/smpi_actor.hpp"
 
 #include "simgrid/sg_config.hpp"
+#include "src/include/xbt/slab.hpp"
 #include "src/kernel/activity/ExecImpl.hpp"
 #include "src/kernel/activity/IoImpl.hpp"
 #include "src/kernel/activity/MailboxImpl.hpp"
@@ -16,6 +17,7 @@
 #include "src/kernel/activity/SynchroRaw.hpp"
 #include "src/mc/mc_record.hpp"
 #include "src/mc/mc_replay.hpp"
+#include "src/simix/TimerWheel.hpp"
 #include "src/simix/smx_private.hpp"
 #include "src/surf/StorageImpl.hpp"
 #include "src/surf/xml/platf.hpp"
@@ -121,23 +123,58 @@ static void install_segvhandler()
 #endif /* _WIN32 */
 
 /********************************* SIMIX **************************************/
+static simgrid::config::Flag<std::string> cfg_timers{
+    "simix/timers", "Implementation of the timers (either heap or wheel)", "heap", [](const std::string& value) {
+      if (value != "heap" && value != "wheel")
+        xbt_die("Invalid timers implementation '%s'. Possible values: heap, wheel", value.c_str());
+    }};
+static simgrid::config::Flag<double> cfg_timer_wheel_tick{
+    "simix/timer-wheel-tick", "Duration of the ticks of the timer wheel (in seconds)", 1e-3, [](double value) {
+      xbt_assert(value > 0, "The ticks of the timer wheel must last a positive duration, not %g", value);
+    }};
+
+/* The implementation is chosen when the first timer is set, once the configuration is known */
+static bool timers_chosen = false;
+static std::unique_ptr<simgrid::simix::TimerWheel> timer_wheel;
+
 namespace simgrid {
 namespace simix {
 
 Timer* Timer::set(double date, simgrid::xbt::Task<void()>&& callback)
 {
-  Timer* timer   = new Timer(date, std::move(callback));
-  timer->handle_ = simix_timers.emplace(std::make_pair(date, timer));
+  if (not timers_chosen) {
+    if (cfg_timers.get() == "wheel")
+      timer_wheel.reset(new TimerWheel(cfg_timer_wheel_tick));
+    timers_chosen = true;
+  }
+  Timer* timer = new Timer(date, std::move(callback));
+  if (timer_wheel)
+    timer_wheel->insert(timer);
+  else
+    timer->handle_ = simix_timers.emplace(std::make_pair(date, timer));
   return timer;
 }
 
 /** @brief cancels a timer that was added earlier */
 void Timer::remove()
 {
-  simgrid::simix::simix_timers.erase(handle_);
+  if (timer_wheel)
+    timer_wheel->remove(this);
+  else
+    simgrid::simix::simix_timers.erase(handle_);
   delete this;
 }
 
+/** @brief Returns the date of the next timer to fire, or -1 if there is none */
+double Timer::next()
+{
+  if (timer_wheel) {
+    const Timer* timer = timer_wheel->top();
+    return timer ? timer->get_date() : -1.0;
+  }
+  return simix_timers.empty() ? -1.0 : simix_timers.top().first;
+}
+
 /** Execute all the tasks that are queued, e.g. `.then()` callbacks of futures. */
 bool Global::execute_tasks()
 {
@@ -283,11 +320,18 @@ void SIMIX_clean()
 
   /* Exit the SIMIX network module */
   SIMIX_mailbox_exit();
+  SIMIX_simcalls_exit();
 
   while (not simgrid::simix::simix_timers.empty()) {
     delete simgrid::simix::simix_timers.top().second;
     simgrid::simix::simix_timers.pop();
   }
+  if (timer_wheel) {
+    while (not timer_wheel->empty())
+      delete timer_wheel->pop();
+    timer_wheel.reset();
+  }
+  timers_chosen = false;
   /* Free the remaining data structures */
   simix_global->actors_to_run.clear();
   simix_global->actors_that_ran.clear();
@@ -307,6 +351,7 @@ void SIMIX_clean()
   SIMIX_context_mod_exit();
 
   surf_exit();
+  simgrid::xbt::SlabAllocator::report();
 
   simix_global = nullptr;
 }
@@ -353,11 +398,21 @@ static void SIMIX_wake_processes()
 static bool SIMIX_execute_timers()
 {
   bool result = false;
-  while (not simgrid::simix::simix_timers.empty() && SIMIX_get_clock() >= simgrid::simix::simix_timers.top().first) {
+  while (true) {
+    smx_timer_t timer;
+    if (timer_wheel) {
+      timer = timer_wheel->top();
+      if (timer == nullptr || SIMIX_get_clock() < timer->get_date())
+        break;
+      timer_wheel->pop();
+    } else {
+      if (simgrid::simix::simix_timers.empty() || SIMIX_get_clock() < simgrid::simix::simix_timers.top().first)
+        break;
+      timer = simgrid::simix::simix_timers.top().second;
+      simgrid::simix::simix_timers.pop();
+    }
     result = true;
     // FIXME: make the timers being real callbacks (i.e. provide dispatchers that read and expand the args)
-    smx_timer_t timer = simgrid::simix::simix_timers.top().second;
-    simgrid::simix::simix_timers.pop();
     try {
       timer->callback();
     } catch (...) {
@@ -464,11 +519,7 @@ void SIMIX_run()
        *   That would thus be a pure waste of time.
        */
 
-      for (smx_actor_t const& process : simix_global->actors_that_ran) {
-        if (process->simcall.call != SIMCALL_NONE) {
-          SIMIX_simcall_handle(&process->simcall, 0);
-        }
-      }
+      SIMIX_simcalls_handle(simix_global->actors_that_ran);
 
       simix_global->execute_tasks();
       do {
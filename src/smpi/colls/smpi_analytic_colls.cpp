@@ -0,0 +1,275 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Analytic collectives: instead of expanding a collective into the point-to-point messages of a given algorithm, the
+ * ranks only exchange one aggregated message per round of a logarithmic algorithm (dissemination, binomial tree or
+ * Bruck), carrying no data but of the size that the round would move. The data itself is exchanged through the memory
+ * of the simulator: each rank leaves a copy of its contribution in a rendezvous point shared by the ranks of the
+ * communicator, and picks the ones it needs once the rounds guarantee that they are all there.
+ *
+ * This simulates an alltoall with O(p log p) messages instead of O(p^2), which makes a difference on large runs.
+ */
+
+#include "colls_private.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace simgrid {
+namespace smpi {
+
+namespace {
+/* Above these sizes, the rounds move the same volume of data as the algorithms for large messages (pairwise exchange
+ * for alltoall, reduce-scatter followed by allgather for allreduce) instead of the one of the logarithmic algorithms */
+constexpr size_t alltoall_bruck_limit     = 256;  // bytes per block
+constexpr size_t allreduce_doubling_limit = 2048; // bytes per vector
+
+/** What the ranks share during an analytic collective */
+struct Rendezvous {
+  std::pair<size_t, unsigned long> key;
+  std::vector<std::vector<unsigned char>> contributions; // by rank
+  std::vector<unsigned char> result;                     // of the reduction, computed once for all the ranks
+  bool reduced = false;
+  int pending; // ranks that did not leave yet
+};
+
+std::mutex rendezvous_mutex; // the actors may run in parallel
+std::map<std::pair<size_t, unsigned long>, Rendezvous*> rendezvous;
+std::map<std::pair<size_t, aid_t>, unsigned long> sequence_numbers; // of the collectives called by each actor
+
+/** Finds (or creates) the rendezvous point of the current collective, and leaves a contribution of the given size
+ *  there. The ranks find each other through the members of the communicator, and the number of collectives that each
+ *  of them called on it so far. */
+Rendezvous* join(MPI_Comm comm, size_t contribution_size)
+{
+  Rendezvous* point;
+  {
+    std::lock_guard<std::mutex> lock(rendezvous_mutex);
+    size_t members = comm->members_hash();
+    std::pair<size_t, unsigned long> key(members, sequence_numbers[{members, s4u::this_actor::get_pid()}]++);
+    auto it = rendezvous.find(key);
+    if (it == rendezvous.end()) {
+      point      = new Rendezvous();
+      point->key = key;
+      point->contributions.resize(comm->size());
+      point->pending = comm->size();
+      rendezvous.emplace(key, point);
+    } else {
+      point = it->second;
+    }
+  }
+  point->contributions[comm->rank()].resize(contribution_size); // nobody else touches this slot for now
+  return point;
+}
+
+void leave(Rendezvous* point)
+{
+  std::lock_guard<std::mutex> lock(rendezvous_mutex);
+  if (--point->pending == 0) {
+    rendezvous.erase(point->key);
+    delete point;
+  }
+}
+
+/** Computes the reduction of all the contributions in rank order (for the non commutative operations), once */
+unsigned char* reduce_contributions(Rendezvous* point, int count, MPI_Datatype datatype, MPI_Op op)
+{
+  std::lock_guard<std::mutex> lock(rendezvous_mutex);
+  if (not point->reduced) {
+    point->result = point->contributions.back();
+    for (int rank = point->contributions.size() - 2; rank >= 0; rank--)
+      op->apply(point->contributions[rank].data(), point->result.data(), &count, datatype);
+    point->reduced = true;
+  }
+  return point->result.data();
+}
+
+int check_size(size_t bytes)
+{
+  xbt_assert(bytes <= static_cast<size_t>(INT_MAX), "Analytic collectives cannot simulate rounds of %zu bytes", bytes);
+  return static_cast<int>(bytes);
+}
+
+int dissemination_rounds(int size)
+{
+  int rounds = 0;
+  for (int distance = 1; distance < size; distance <<= 1)
+    rounds++;
+  return rounds;
+}
+
+/** Simulates the ceil(log2(p)) rounds of a dissemination, where each rank sends to rank+2^k and receives from
+ *  rank-2^k at round k. Once done, every rank is causally after all the others. */
+template <class F> void disseminate(MPI_Comm comm, int tag, F round_bytes)
+{
+  int rank = comm->rank();
+  int size = comm->size();
+  for (int k = 0, distance = 1; distance < size; k++, distance <<= 1) {
+    int bytes = check_size(round_bytes(k, distance));
+    Request::sendrecv(nullptr, bytes, MPI_BYTE, (rank + distance) % size, tag, nullptr, bytes, MPI_BYTE,
+                      (rank - distance + size) % size, tag, comm, MPI_STATUS_IGNORE);
+  }
+}
+
+/** Simulates a binomial broadcast of the given size from the root: each rank receives once from its parent, and
+ *  then sends to its children */
+void binomial_broadcast(MPI_Comm comm, int tag, int root, size_t size_bytes)
+{
+  int size  = comm->size();
+  int vrank = (comm->rank() - root + size) % size;
+  int bytes = check_size(size_bytes);
+  int mask  = 1;
+  while (mask < size) {
+    if (vrank & mask) {
+      Request::recv(nullptr, bytes, MPI_BYTE, (vrank - mask + root) % size, tag, comm, MPI_STATUS_IGNORE);
+      break;
+    }
+    mask <<= 1;
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1)
+    if (vrank + mask < size)
+      Request::send(nullptr, bytes, MPI_BYTE, (vrank + mask + root) % size, tag, comm);
+}
+
+/** Simulates a binomial reduction of the given size to the root, the converse of the broadcast */
+void binomial_reduction(MPI_Comm comm, int tag, int root, size_t size_bytes)
+{
+  int size  = comm->size();
+  int vrank = (comm->rank() - root + size) % size;
+  int bytes = check_size(size_bytes);
+  for (int mask = 1; mask < size; mask <<= 1) {
+    if (vrank & mask) {
+      Request::send(nullptr, bytes, MPI_BYTE, (vrank - mask + root) % size, tag, comm);
+      break;
+    }
+    if (vrank + mask < size)
+      Request::recv(nullptr, bytes, MPI_BYTE, (vrank + mask + root) % size, tag, comm, MPI_STATUS_IGNORE);
+  }
+}
+
+/** Number of integers of [0, n) whose bit k is set: the blocks that move at round k of a Bruck alltoall */
+size_t blocks_with_bit(int n, int k)
+{
+  size_t period = size_t(1) << (k + 1);
+  size_t half   = size_t(1) << k;
+  size_t rest   = n % period;
+  return (n / period) * half + (rest > half ? rest - half : 0);
+}
+} // namespace
+
+int Coll_barrier_analytic::barrier(MPI_Comm comm)
+{
+  disseminate(comm, COLL_TAG_BARRIER, [](int, int) { return 0; });
+  return MPI_SUCCESS;
+}
+
+int Coll_bcast_analytic::bcast(void* buf, int count, MPI_Datatype datatype, int root, MPI_Comm comm)
+{
+  if (comm->size() == 1)
+    return MPI_SUCCESS;
+  size_t bytes      = count * datatype->size();
+  bool is_root      = comm->rank() == root;
+  Rendezvous* point = join(comm, is_root ? bytes : 0);
+  if (is_root)
+    Datatype::copy(buf, count, datatype, point->contributions[root].data(), bytes, MPI_BYTE);
+
+  binomial_broadcast(comm, COLL_TAG_BCAST, root, bytes);
+
+  if (not is_root)
+    Datatype::copy(point->contributions[root].data(), bytes, MPI_BYTE, buf, count, datatype);
+  leave(point);
+  return MPI_SUCCESS;
+}
+
+int Coll_reduce_analytic::reduce(void* buf, void* rbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+                                 MPI_Comm comm)
+{
+  if (comm->size() == 1)
+    return Datatype::copy(buf, count, datatype, rbuf, count, datatype);
+  MPI_Aint extent   = datatype->get_extent();
+  Rendezvous* point = join(comm, count * extent);
+  Datatype::copy(buf, count, datatype, point->contributions[comm->rank()].data(), count, datatype);
+
+  binomial_reduction(comm, COLL_TAG_REDUCE, root, count * datatype->size());
+
+  if (comm->rank() == root)
+    Datatype::copy(reduce_contributions(point, count, datatype, op), count, datatype, rbuf, count, datatype);
+  leave(point);
+  return MPI_SUCCESS;
+}
+
+int Coll_allreduce_analytic::allreduce(void* sbuf, void* rbuf, int rcount, MPI_Datatype dtype, MPI_Op op,
+                                       MPI_Comm comm)
+{
+  if (comm->size() == 1)
+    return Datatype::copy(sbuf, rcount, dtype, rbuf, rcount, dtype);
+  MPI_Aint extent   = dtype->get_extent();
+  Rendezvous* point = join(comm, rcount * extent);
+  Datatype::copy(sbuf, rcount, dtype, point->contributions[comm->rank()].data(), rcount, dtype);
+
+  size_t bytes = rcount * dtype->size();
+  if (bytes <= allreduce_doubling_limit) { // Recursive doubling: the whole vector at each round
+    disseminate(comm, COLL_TAG_ALLREDUCE, [bytes](int, int) { return bytes; });
+  } else { // Recursive halving, and then doubling
+    int rounds = dissemination_rounds(comm->size());
+    disseminate(comm, COLL_TAG_ALLREDUCE, [bytes](int k, int) { return bytes >> (k + 1); });
+    disseminate(comm, COLL_TAG_ALLREDUCE, [bytes, rounds](int k, int) { return bytes >> (rounds - k); });
+  }
+
+  Datatype::copy(reduce_contributions(point, rcount, dtype, op), rcount, dtype, rbuf, rcount, dtype);
+  leave(point);
+  return MPI_SUCCESS;
+}
+
+int Coll_allgather_analytic::allgather(void* send_buff, int send_count, MPI_Datatype send_type, void* recv_buff,
+                                       int recv_count, MPI_Datatype recv_type, MPI_Comm comm)
+{
+  int size          = comm->size();
+  size_t block      = send_count * send_type->size();
+  Rendezvous* point = join(comm, block);
+  Datatype::copy(send_buff, send_count, send_type, point->contributions[comm->rank()].data(), block, MPI_BYTE);
+
+  // Bruck: the blocks gathered so far at each round
+  disseminate(comm, COLL_TAG_ALLGATHER,
+              [size, block](int, int distance) { return std::min(distance, size - distance) * block; });
+
+  MPI_Aint extent = recv_type->get_extent();
+  for (int rank = 0; rank < size; rank++)
+    Datatype::copy(point->contributions[rank].data(), block, MPI_BYTE,
+                   static_cast<char*>(recv_buff) + rank * recv_count * extent, recv_count, recv_type);
+  leave(point);
+  return MPI_SUCCESS;
+}
+
+int Coll_alltoall_analytic::alltoall(void* send_buff, int send_count, MPI_Datatype send_type, void* recv_buff,
+                                     int recv_count, MPI_Datatype recv_type, MPI_Comm comm)
+{
+  int size          = comm->size();
+  int me            = comm->rank();
+  size_t block      = send_count * send_type->size();
+  Rendezvous* point = join(comm, size * block);
+  Datatype::copy(send_buff, size * send_count, send_type, point->contributions[me].data(), size * block, MPI_BYTE);
+
+  if (block <= alltoall_bruck_limit) { // Bruck: the blocks whose index has the bit of the round set
+    disseminate(comm, COLL_TAG_ALLTOALL, [size, block](int k, int) { return blocks_with_bit(size, k) * block; });
+  } else { // Pairwise exchange: the p-1 blocks spread over the rounds
+    int rounds = dissemination_rounds(size);
+    disseminate(comm, COLL_TAG_ALLTOALL,
+                [size, block, rounds](int k, int) { return (size - 1 + k) / rounds * block; });
+  }
+
+  MPI_Aint extent = recv_type->get_extent();
+  for (int rank = 0; rank < size; rank++)
+    Datatype::copy(point->contributions[rank].data() + me * block, block, MPI_BYTE,
+                   static_cast<char*>(recv_buff) + rank * recv_count * extent, recv_count, recv_type);
+  leave(point);
+  return MPI_SUCCESS;
+}
+
+} // namespace smpi
+} // namespace simgrid
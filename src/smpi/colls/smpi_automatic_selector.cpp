@@ -33,6 +33,8 @@
         continue;                                                                                                      \
       if (Colls::mpi_coll_##cat##_description[i].name == "default")                                                    \
         continue;                                                                                                      \
+      if (Colls::mpi_coll_##cat##_description[i].name == "analytic")                                                   \
+        continue;                                                                                                      \
       Coll_barrier_default::barrier(comm);                                                                             \
       TRACE_AUTO_COLL(cat)                                                                                             \
       time1 = SIMIX_get_clock();                                                                                       \
@@ -220,6 +220,7 @@ COLL_APPLY(action, COLL_ALLGATHER_SIG, mvapich2) COLL_sep \
 COLL_APPLY(action, COLL_ALLGATHER_SIG, mvapich2_smp) COLL_sep \
 COLL_APPLY(action, COLL_ALLGATHER_SIG, mpich) COLL_sep \
 COLL_APPLY(action, COLL_ALLGATHER_SIG, impi) COLL_sep \
+COLL_APPLY(action, COLL_ALLGATHER_SIG, analytic) COLL_sep \
 COLL_APPLY(action, COLL_ALLGATHER_SIG, automatic)
 
 COLL_ALLGATHERS(COLL_PROTO, COLL_NOsep)
@@ -271,6 +272,7 @@ COLL_APPLY(action, COLL_ALLREDUCE_SIG, mvapich2_rs) COLL_sep \
 COLL_APPLY(action, COLL_ALLREDUCE_SIG, mvapich2_two_level) COLL_sep \
 COLL_APPLY(action, COLL_ALLREDUCE_SIG, impi) COLL_sep \
 COLL_APPLY(action, COLL_ALLREDUCE_SIG, rab) COLL_sep \
+COLL_APPLY(action, COLL_ALLREDUCE_SIG, analytic) COLL_sep \
 COLL_APPLY(action, COLL_ALLREDUCE_SIG, automatic)
 
 COLL_ALLREDUCES(COLL_PROTO, COLL_NOsep)
@@ -300,6 +302,7 @@ COLL_APPLY(action, COLL_ALLTOALL_SIG, mvapich2_scatter_dest) COLL_sep \
 COLL_APPLY(action, COLL_ALLTOALL_SIG, ompi) COLL_sep \
 COLL_APPLY(action, COLL_ALLTOALL_SIG, mpich) COLL_sep \
 COLL_APPLY(action, COLL_ALLTOALL_SIG, impi) COLL_sep \
+COLL_APPLY(action, COLL_ALLTOALL_SIG, analytic) COLL_sep \
 COLL_APPLY(action, COLL_ALLTOALL_SIG, automatic)
 
 COLL_ALLTOALLS(COLL_PROTO, COLL_NOsep)
@@ -357,6 +360,7 @@ COLL_APPLY(action, COLL_BCAST_SIG, mvapich2_inter_node)   COLL_sep \
 COLL_APPLY(action, COLL_BCAST_SIG, mvapich2_intra_node)   COLL_sep \
 COLL_APPLY(action, COLL_BCAST_SIG, mvapich2_knomial_intra_node)   COLL_sep \
 COLL_APPLY(action, COLL_BCAST_SIG, impi)   COLL_sep \
+COLL_APPLY(action, COLL_BCAST_SIG, analytic) COLL_sep \
 COLL_APPLY(action, COLL_BCAST_SIG, automatic)
 
 COLL_BCASTS(COLL_PROTO, COLL_NOsep)
@@ -385,6 +389,7 @@ COLL_APPLY(action, COLL_REDUCE_SIG, mvapich2_knomial) COLL_sep \
 COLL_APPLY(action, COLL_REDUCE_SIG, mvapich2_two_level) COLL_sep \
 COLL_APPLY(action, COLL_REDUCE_SIG, impi) COLL_sep \
 COLL_APPLY(action, COLL_REDUCE_SIG, rab) COLL_sep \
+COLL_APPLY(action, COLL_REDUCE_SIG, analytic) COLL_sep \
 COLL_APPLY(action, COLL_REDUCE_SIG, automatic)
 
 COLL_REDUCES(COLL_PROTO, COLL_NOsep)
@@ -444,6 +449,7 @@ COLL_APPLY(action, COLL_BARRIER_SIG, mpich)   COLL_sep \
 COLL_APPLY(action, COLL_BARRIER_SIG, mvapich2_pair)   COLL_sep \
 COLL_APPLY(action, COLL_BARRIER_SIG, mvapich2)   COLL_sep \
 COLL_APPLY(action, COLL_BARRIER_SIG, impi)   COLL_sep \
+COLL_APPLY(action, COLL_BARRIER_SIG, analytic) COLL_sep \
 COLL_APPLY(action, COLL_BARRIER_SIG, automatic)
 
 COLL_BARRIERS(COLL_PROTO, COLL_NOsep)
@@ -31,6 +31,7 @@ class Comm : public F2C, public Keyval{
   std::list<MPI_Win> rma_wins_; // attached windows for synchronization.
   std::string name_;
   MPI_Info info_;
+  size_t members_hash_ = 0;
 
 public:
   static std::unordered_map<int, smpi_key_elem> keyvals_;
@@ -43,6 +44,7 @@ public:
   MPI_Topology topo() { return topo_; }
   int size();
   int rank();
+  size_t members_hash();
   void get_name(char* name, int* len);
   void set_name(char* name);
   MPI_Info info();
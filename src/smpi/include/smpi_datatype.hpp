@@ -8,7 +8,9 @@
 
 #include "smpi_f2c.hpp"
 #include "smpi_keyvals.hpp"
+#include <mutex>
 #include <string>
+#include <vector>
 
 constexpr unsigned DT_FLAG_DESTROYED   = 0x0001; /**< user destroyed but some other layers still have a reference */
 constexpr unsigned DT_FLAG_COMMITED    = 0x0002; /**< ready to be used for a send/recv operation */
@@ -77,6 +79,17 @@ namespace simgrid{
 namespace smpi{
 
 class Datatype : public F2C, public Keyval{
+public:
+  /** Runs of contiguous bytes in the layout of a datatype, relative to the start of an element: count runs of the
+   *  same length, each one stride bytes after the previous one */
+  struct Segment {
+    MPI_Aint offset;
+    size_t length;
+    int count;
+    MPI_Aint stride;
+  };
+
+private:
   char* name_;
   /* The id here is the (unique) datatype id used for this datastructure.
    * It's default value is set to -1 since some code expects this return value
@@ -88,6 +101,20 @@ class Datatype : public F2C, public Keyval{
   MPI_Aint ub_;
   int flags_;
   int refcount_;
+  /* The runs of bytes of one element of a derived type, in the order of the serialization. Computed the first time that
+   * the type is (un)serialized, so that it is not walked through its tree of subtypes any more. Stays empty if there
+   * are too many of them. */
+  std::once_flag segments_flag_;
+  std::vector<Segment> segments_;
+
+  const std::vector<Segment>& get_segments();
+
+protected:
+  static constexpr size_t max_segments = 4096;
+  static void add_segment(std::vector<Segment>& segments, MPI_Aint offset, size_t length);
+  static void flatten_block(std::vector<Segment>& segments, MPI_Aint offset, int count, MPI_Datatype type);
+  bool serialize_segments(void* noncontiguous, void* contiguous, int count);
+  bool unserialize_segments(void* contiguous, void* noncontiguous, int count, MPI_Op op);
 
 public:
   static std::unordered_map<int, smpi_key_elem> keyvals_;
@@ -126,6 +153,8 @@ public:
                   MPI_Datatype recvtype);
   virtual void serialize(void* noncontiguous, void* contiguous, int count);
   virtual void unserialize(void* contiguous, void* noncontiguous, int count, MPI_Op op);
+  /** Appends the runs of bytes of one element located at the given offset (stops after max_segments runs) */
+  virtual void flatten(std::vector<Segment>& segments, MPI_Aint offset);
   static int keyval_create(MPI_Type_copy_attr_function* copy_fn, MPI_Type_delete_attr_function* delete_fn, int* keyval,
                            void* extra_state);
   static int keyval_free(int* keyval);
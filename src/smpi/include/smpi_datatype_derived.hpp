@@ -23,6 +23,7 @@ public:
   ~Type_Contiguous();
   void serialize(void* noncontiguous, void* contiguous, int count);
   void unserialize(void* contiguous_vector, void* noncontiguous_vector, int count, MPI_Op op);
+  void flatten(std::vector<Segment>& segments, MPI_Aint offset);
 };
 
 class Type_Hvector: public Datatype{
@@ -39,6 +40,7 @@ public:
   ~Type_Hvector();
   void serialize(void* noncontiguous, void* contiguous, int count);
   void unserialize(void* contiguous_vector, void* noncontiguous_vector, int count, MPI_Op op);
+  void flatten(std::vector<Segment>& segments, MPI_Aint offset);
 };
 
 class Type_Vector : public Type_Hvector {
@@ -63,6 +65,7 @@ public:
   ~Type_Hindexed();
   void serialize(void* noncontiguous, void* contiguous, int count);
   void unserialize(void* contiguous_vector, void* noncontiguous_vector, int count, MPI_Op op);
+  void flatten(std::vector<Segment>& segments, MPI_Aint offset);
 };
 
 class Type_Indexed : public Type_Hindexed {
@@ -85,6 +88,7 @@ public:
   ~Type_Struct();
   void serialize(void* noncontiguous, void* contiguous, int count);
   void unserialize(void* contiguous_vector, void* noncontiguous_vector, int count, MPI_Op op);
+  void flatten(std::vector<Segment>& segments, MPI_Aint offset);
 };
 
 } // namespace smpi
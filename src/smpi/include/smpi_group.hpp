@@ -9,7 +9,7 @@
 
 #include "smpi_f2c.hpp"
 #include <smpi/smpi.h>
-#include <map>
+#include <utility>
 #include <vector>
 
 namespace simgrid{
@@ -21,17 +21,27 @@ class Group : public F2C{
    * For a vector, this costs O(1). We hence go with the vector.
    */
   std::vector<s4u::ActorPtr> rank_to_actor_map_;
-  std::map<s4u::ActorPtr, int> actor_to_rank_map_;
-  std::vector<int> index_to_rank_map_;
+  /* The rank of an actor is computed from its PID without any table as long as the PIDs of the ranks form an
+   * arithmetic progression, as in MPI_COMM_WORLD or in the regular splits of it. The other groups keep the ranks in a
+   * flat hash table indexed by PID, where empty slots have an undefined rank.
+   */
+  int first_rank_   = MPI_UNDEFINED; /* Any mapped rank, and the PID of its actor */
+  aid_t first_pid_  = 0;
+  aid_t pid_stride_ = 0; /* Difference between the PIDs of consecutive ranks, known once two ranks are mapped */
+  std::vector<std::pair<aid_t, int>> pid_to_rank_;
+  int hash_shift_ = 0;
+
+  void hash_insert(aid_t pid, int rank);
+  void hash_all_ranks();
 
   int refcount_ = 1; /* refcount_: start > 0 so that this group never gets freed */
 public:
   Group() = default;
-  explicit Group(int size) : size_(size), rank_to_actor_map_(size, nullptr), index_to_rank_map_(size, MPI_UNDEFINED) {}
+  explicit Group(int size) : size_(size), rank_to_actor_map_(size, nullptr) {}
   explicit Group(Group* origin);
 
   void set_mapping(s4u::ActorPtr actor, int rank);
-  int rank(int index);
+  int rank(aid_t pid);
   s4u::ActorPtr actor(int rank);
   int rank(const s4u::ActorPtr process);
   void ref();
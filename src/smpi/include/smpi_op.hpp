@@ -13,19 +13,33 @@ namespace simgrid{
 namespace smpi{
 
 class Op : public F2C{
+public:
+  /** Loop applying a predefined operation to len elements of a given type */
+  using Kernel = void (*)(const void* invec, void* inoutvec, int len);
+  /** Returns the loop of a predefined operation for the given datatype, or nullptr if it does not apply to it */
+  using KernelFinder = Kernel (*)(MPI_Datatype datatype);
+
+private:
   MPI_User_function* func_;
+  KernelFinder find_kernel_;
   bool is_commutative_;
   bool is_fortran_op_ = false;
   int refcount_ = 1;
   bool predefined_;
 
 public:
-  Op(MPI_User_function* function, bool commutative, bool predefined=false) : func_(function), is_commutative_(commutative), predefined_(predefined) {}
+  Op(MPI_User_function* function, bool commutative, bool predefined = false, KernelFinder find_kernel = nullptr)
+      : func_(function), find_kernel_(find_kernel), is_commutative_(commutative), predefined_(predefined)
+  {
+  }
   bool is_commutative() { return is_commutative_; }
   bool is_fortran_op() { return is_fortran_op_; }
   // tell that we were created from fortran, so we need to translate the type to fortran when called
   void set_fortran_op() { is_fortran_op_ = true; }
   void apply(void* invec, void* inoutvec, int* len, MPI_Datatype datatype);
+  /** Applies the operation to count blocks of len elements, contiguous in invec and separated by stride bytes in
+   *  inoutvec, looking for the loop of the datatype only once */
+  void apply_strided(void* invec, void* inoutvec, int count, int len, MPI_Aint stride, MPI_Datatype datatype);
   static Op* f2c(int id);
   void ref();
   static void unref(MPI_Op* op);
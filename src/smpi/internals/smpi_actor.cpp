@@ -6,8 +6,11 @@
 #include "src/smpi/include/smpi_actor.hpp"
 #include "mc/mc.h"
 #include "smpi_comm.hpp"
+#include "smpi_request.hpp"
+#include "src/kernel/activity/MailboxImpl.hpp"
 #include "src/mc/mc_replay.hpp"
 #include "src/simix/smx_private.hpp"
+#include "xbt/config.hpp"
 
 #if HAVE_PAPI
 #include "papi.h"
@@ -16,6 +19,9 @@ extern std::string papi_default_config_name;
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(smpi_process, smpi, "Logging specific to SMPI (kernel)");
 
+static simgrid::config::Flag<bool> cfg_indexed_matching(
+    "smpi/indexed-matching", "Index the pending messages of each mailbox by source and tag, to match them faster", true);
+
 namespace simgrid {
 namespace smpi {
 
@@ -68,6 +74,14 @@ void ActorExt::set_data(const char* instance_id)
 
   // set the process attached to the mailbox
   mailbox_small_->set_receiver(actor_);
+  if (cfg_indexed_matching) {
+    kernel::activity::MailboxImpl* mailbox       = mailbox_->get_impl();
+    kernel::activity::MailboxImpl* mailbox_small = mailbox_small_->get_impl();
+    simix::simcall([mailbox, mailbox_small] {
+      mailbox->set_match_key(&Request::match_key);
+      mailbox_small->set_match_key(&Request::match_key);
+    });
+  }
   XBT_DEBUG("<%ld> SMPI process has been initialized: %p", actor_->get_pid(), actor_.get());
 }
 
@@ -12,7 +12,12 @@
 #include "src/smpi/include/smpi_actor.hpp"
 #include "src/surf/HostImpl.hpp"
 
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <atomic>
 #include <climits>
+#include <mutex>
+#include <tuple>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(smpi_comm, smpi, "Logging specific to SMPI (comm)");
 
@@ -110,7 +115,21 @@ int Comm::rank()
 {
   if (this == MPI_COMM_UNINITIALIZED)
     return smpi_process()->comm_world()->rank();
-  return group_->rank(s4u::Actor::self());
+  return group_->rank(s4u::this_actor::get_pid());
+}
+
+/** @brief Hash of the actors of the communicator, that is the same on all of its ranks */
+size_t Comm::members_hash()
+{
+  if (this == MPI_COMM_UNINITIALIZED)
+    return smpi_process()->comm_world()->members_hash();
+  if (members_hash_ == 0) {
+    size_t hash = group_->size();
+    for (int i = 0; i < group_->size(); i++)
+      boost::hash_combine(hash, group_->actor(i)->get_pid());
+    members_hash_ = hash;
+  }
+  return members_hash_;
 }
 
 void Comm::get_name (char* name, int* len)
@@ -190,80 +209,63 @@ int Comm::is_smp_comm(){
   return is_smp_comm_;
 }
 
+/** @brief State of an MPI_Comm_split call, shared by all the ranks of the communicator
+ *
+ * Every rank writes its color and key in the table. The first rank leaving the barrier sorts it and builds all the new
+ * groups, that are shared by their members, and the last rank leaving the call frees it.
+ */
+struct SplitCall {
+  std::vector<std::tuple<int, int, int>> entries; // color, key and rank in the split communicator
+  std::vector<MPI_Group> groups;                  // new group of each rank, or nullptr
+  std::once_flag groups_built;
+  std::atomic<int> remaining;
+
+  explicit SplitCall(int size) : entries(size), groups(size, nullptr), remaining(size) {}
+  void build_groups(MPI_Group group);
+};
+
+void SplitCall::build_groups(MPI_Group group)
+{
+  std::sort(begin(entries), end(entries));
+  auto first = std::find_if(begin(entries), end(entries),
+                            [](std::tuple<int, int, int> const& entry) { return std::get<0>(entry) != MPI_UNDEFINED; });
+  while (first != end(entries)) {
+    int color = std::get<0>(*first);
+    auto last = std::find_if(first, end(entries),
+                             [color](std::tuple<int, int, int> const& entry) { return std::get<0>(entry) != color; });
+    MPI_Group group_out = new Group(static_cast<int>(last - first));
+    int new_rank        = 0;
+    for (auto entry = first; entry != last; ++entry) {
+      int rank = std::get<2>(*entry);
+      group_out->set_mapping(group->actor(rank), new_rank);
+      if (new_rank > 0) // each member of the new communicator owns a reference
+        group_out->ref();
+      groups[rank] = group_out;
+      new_rank++;
+    }
+    first = last;
+  }
+}
+
 MPI_Comm Comm::split(int color, int key)
 {
   if (this == MPI_COMM_UNINITIALIZED)
     return smpi_process()->comm_world()->split(color, key);
-  int system_tag = 123;
-  int* recvbuf;
-
-  MPI_Group group_root = nullptr;
-  MPI_Group group_out  = nullptr;
-  MPI_Group group      = this->group();
-  int myrank           = this->rank();
-  int size             = this->size();
-  /* Gather all colors and keys on rank 0 */
-  int* sendbuf = xbt_new(int, 2);
-  sendbuf[0] = color;
-  sendbuf[1] = key;
-  if (myrank == 0) {
-    recvbuf = xbt_new(int, 2 * size);
-  } else {
-    recvbuf = nullptr;
-  }
-  Coll_gather_default::gather(sendbuf, 2, MPI_INT, recvbuf, 2, MPI_INT, 0, this);
-  xbt_free(sendbuf);
-  /* Do the actual job */
-  if (myrank == 0) {
-    MPI_Group* group_snd = xbt_new(MPI_Group, size);
-    std::vector<std::pair<int, int>> rankmap;
-    rankmap.reserve(size);
-    for (int i = 0; i < size; i++) {
-      if (recvbuf[2 * i] != MPI_UNDEFINED) {
-        rankmap.clear();
-        for (int j = i + 1; j < size; j++) {
-          if(recvbuf[2 * i] == recvbuf[2 * j]) {
-            recvbuf[2 * j] = MPI_UNDEFINED;
-            rankmap.push_back({recvbuf[2 * j + 1], j});
-          }
-        }
-        /* Add self in the group */
-        recvbuf[2 * i] = MPI_UNDEFINED;
-        rankmap.push_back({recvbuf[2 * i + 1], i});
-        std::sort(begin(rankmap), end(rankmap));
-        group_out = new Group(rankmap.size());
-        if (i == 0) {
-          group_root = group_out; /* Save root's group */
-        }
-        for (unsigned j = 0; j < rankmap.size(); j++) {
-          s4u::ActorPtr actor = group->actor(rankmap[j].second);
-          group_out->set_mapping(actor, j);
-        }
-        MPI_Request* requests = xbt_new(MPI_Request, rankmap.size());
-        int reqs              = 0;
-        for (auto const& rank : rankmap) {
-          if (rank.second != 0) {
-            group_snd[reqs]=new  Group(group_out);
-            requests[reqs] = Request::isend(&(group_snd[reqs]), 1, MPI_PTR, rank.second, system_tag, this);
-            reqs++;
-          }
-        }
-        if(i != 0 && group_out != MPI_COMM_WORLD->group() && group_out != MPI_GROUP_EMPTY)
-          Group::unref(group_out);
-
-        Request::waitall(reqs, requests, MPI_STATUS_IGNORE);
-        xbt_free(requests);
-      }
-    }
-    xbt_free(recvbuf);
-    xbt_free(group_snd);
-    group_out = group_root; /* exit with root's group */
-  } else {
-    if(color != MPI_UNDEFINED) {
-      Request::recv(&group_out, 1, MPI_PTR, 0, system_tag, this, MPI_STATUS_IGNORE);
-    } /* otherwise, exit with group_out == nullptr */
-  }
-  return group_out!=nullptr ? new  Comm(group_out, nullptr) : MPI_COMM_NULL;
+  int myrank = this->rank();
+
+  /* All the ranks share the address space: rank 0 gives them a table where they all write their color and key */
+  SplitCall* call = nullptr;
+  if (myrank == 0)
+    call = new SplitCall(this->size());
+  Coll_bcast_default::bcast(&call, 1, MPI_PTR, 0, this);
+  call->entries[myrank] = std::make_tuple(color, key, myrank);
+  Coll_barrier_ompi_bruck::barrier(this);
+
+  std::call_once(call->groups_built, &SplitCall::build_groups, call, this->group());
+  MPI_Group group_out = call->groups[myrank];
+  if (--call->remaining == 0)
+    delete call;
+  return group_out != nullptr ? new Comm(group_out, nullptr) : MPI_COMM_NULL;
 }
 
 void Comm::ref(){
@@ -125,7 +125,7 @@ Datatype::Datatype(char* name, int ident, int size, MPI_Aint lb, MPI_Aint ub, in
 #endif
 }
 
-Datatype::Datatype(Datatype *datatype, int* ret) : name_(nullptr), size_(datatype->size_), lb_(datatype->lb_), ub_(datatype->ub_), flags_(datatype->flags_), refcount_(1)
+Datatype::Datatype(Datatype *datatype, int* ret) : name_(nullptr), size_(datatype->size_), lb_(datatype->lb_), ub_(datatype->ub_), flags_(datatype->flags_), refcount_(1), segments_(datatype->get_segments())
 {
   flags_ &= ~DT_FLAG_PREDEFINED;
   *ret = MPI_SUCCESS;
@@ -303,15 +303,135 @@ int Datatype::copy(void *sendbuf, int sendcount, MPI_Datatype sendtype,
   return sendcount > recvcount ? MPI_ERR_TRUNCATE : MPI_SUCCESS;
 }
 
+void Datatype::add_segment(std::vector<Segment>& segments, MPI_Aint offset, size_t length)
+{
+  if (length == 0)
+    return;
+  if (not segments.empty()) {
+    Segment& last = segments.back();
+    if (last.count == 1 && last.offset + static_cast<MPI_Aint>(last.length) == offset) { // merge with the previous run
+      last.length += length;
+      return;
+    }
+    if (last.length == length && (last.count == 1 || offset == last.offset + last.count * last.stride)) {
+      if (last.count == 1) // second run of this length: this gives the stride of the following ones
+        last.stride = offset - last.offset;
+      last.count++;
+      return;
+    }
+  }
+  segments.push_back({offset, length, 1, 0});
+}
+
+/** Appends the runs of count consecutive elements of the given type, as serialized by the derived types */
+void Datatype::flatten_block(std::vector<Segment>& segments, MPI_Aint offset, int count, MPI_Datatype type)
+{
+  if (not(type->flags() & DT_FLAG_DERIVED))
+    add_segment(segments, offset, count * type->size());
+  else
+    for (int i = 0; i < count && segments.size() <= max_segments; i++)
+      type->flatten(segments, offset + i * type->get_extent());
+}
+
+void Datatype::flatten(std::vector<Segment>& segments, MPI_Aint offset)
+{
+  if (segments_.empty()) {
+    add_segment(segments, offset + lb_, size_);
+  } else {
+    for (auto const& segment : segments_)
+      for (int i = 0; i < segment.count; i++)
+        add_segment(segments, offset + segment.offset + i * segment.stride, segment.length);
+  }
+}
+
+const std::vector<Datatype::Segment>& Datatype::get_segments()
+{
+  std::call_once(segments_flag_, [this]() {
+    if (not(flags_ & DT_FLAG_DERIVED))
+      return;
+    std::vector<Segment> segments;
+    flatten(segments, 0);
+    size_t size = 0;
+    for (auto const& segment : segments)
+      size += segment.length * segment.count;
+    if (segments.size() <= max_segments && size == size_) // Otherwise, keep on walking the tree of subtypes
+      segments_ = std::move(segments);
+    XBT_DEBUG("Datatype %p flattened into %zu segments", this, segments_.size());
+  });
+  return segments_;
+}
+
+/** Serializes the elements with one memcpy per run of bytes, if the datatype could be flattened */
+bool Datatype::serialize_segments(void* noncontiguous_buf, void* contiguous_buf, int count)
+{
+  const std::vector<Segment>& segments = get_segments();
+  if (segments.empty())
+    return false;
+  char* contiguous_buf_char    = static_cast<char*>(contiguous_buf);
+  char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf);
+  MPI_Aint extent              = get_extent();
+  if (segments.size() == 1 && segments[0].count == 1 && static_cast<MPI_Aint>(segments[0].length) == extent) {
+    memcpy(contiguous_buf_char, noncontiguous_buf_char + segments[0].offset, count * size_); // no gap at all
+    return true;
+  }
+  for (int i = 0; i < count; i++) {
+    for (auto const& segment : segments) {
+      char* run = noncontiguous_buf_char + segment.offset;
+      for (int j = 0; j < segment.count; j++) {
+        memcpy(contiguous_buf_char, run, segment.length);
+        contiguous_buf_char += segment.length;
+        run += segment.stride;
+      }
+    }
+    noncontiguous_buf_char += extent;
+  }
+  return true;
+}
+
+/** Same for the unserialization, but only when the data is replaced: the other operations depend on the types */
+bool Datatype::unserialize_segments(void* contiguous_buf, void* noncontiguous_buf, int count, MPI_Op op)
+{
+  if (op != MPI_REPLACE)
+    return false;
+  const std::vector<Segment>& segments = get_segments();
+  if (segments.empty())
+    return false;
+  if (smpi_process()->replaying())
+    return true;
+  char* contiguous_buf_char    = static_cast<char*>(contiguous_buf);
+  char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf);
+  MPI_Aint extent              = get_extent();
+  if (segments.size() == 1 && segments[0].count == 1 && static_cast<MPI_Aint>(segments[0].length) == extent) {
+    memcpy(noncontiguous_buf_char + segments[0].offset, contiguous_buf_char, count * size_);
+    return true;
+  }
+  for (int i = 0; i < count; i++) {
+    for (auto const& segment : segments) {
+      char* run = noncontiguous_buf_char + segment.offset;
+      for (int j = 0; j < segment.count; j++) {
+        memcpy(run, contiguous_buf_char, segment.length);
+        contiguous_buf_char += segment.length;
+        run += segment.stride;
+      }
+    }
+    noncontiguous_buf_char += extent;
+  }
+  return true;
+}
+
 //Default serialization method : memcpy.
 void Datatype::serialize(void* noncontiguous_buf, void* contiguous_buf, int count)
 {
+  if (serialize_segments(noncontiguous_buf, contiguous_buf, count))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf)+lb_;
   memcpy(contiguous_buf_char, noncontiguous_buf_char, count*size_);
 }
 
 void Datatype::unserialize( void* contiguous_buf, void *noncontiguous_buf, int count, MPI_Op op){
+  if (unserialize_segments(contiguous_buf, noncontiguous_buf, count, op))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf)+lb_;
   int n=count;
@@ -40,6 +40,11 @@ void Type_Contiguous::unserialize(void* contiguous_buf, void* noncontiguous_buf,
     op->apply( contiguous_buf_char, noncontiguous_buf_char, &n, old_type_);
 }
 
+void Type_Contiguous::flatten(std::vector<Segment>& segments, MPI_Aint offset)
+{
+  add_segment(segments, offset + lb(), block_count_ * old_type_->size());
+}
+
 Type_Hvector::Type_Hvector(int size,MPI_Aint lb, MPI_Aint ub, int flags, int count, int block_length, MPI_Aint stride, MPI_Datatype old_type): Datatype(size, lb, ub, flags), block_count_(count), block_length_(block_length), block_stride_(stride), old_type_(old_type){
   old_type->ref();
 }
@@ -49,6 +54,8 @@ Type_Hvector::~Type_Hvector(){
 
 void Type_Hvector::serialize( void* noncontiguous_buf, void *contiguous_buf,
                     int count){
+  if (serialize_segments(noncontiguous_buf, contiguous_buf, count))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf);
 
@@ -68,15 +75,23 @@ void Type_Hvector::serialize( void* noncontiguous_buf, void *contiguous_buf,
 
 void Type_Hvector::unserialize( void* contiguous_buf, void *noncontiguous_buf,
                               int count, MPI_Op op){
+  if (unserialize_segments(contiguous_buf, noncontiguous_buf, count, op))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf);
 
+  if (not(old_type_->flags() & DT_FLAG_DERIVED)) { // reduce all the blocks of each vector at once
+    for (int i = 0; i < count; i++) {
+      if (op != MPI_OP_NULL)
+        op->apply_strided(contiguous_buf_char, noncontiguous_buf_char, block_count_, block_length_, block_stride_,
+                          old_type_);
+      contiguous_buf_char += block_count_ * block_length_ * old_type_->size();
+      noncontiguous_buf_char += (block_count_ - 1) * block_stride_ + block_length_ * old_type_->size();
+    }
+    return;
+  }
   for (int i = 0; i < block_count_ * count; i++) {
-    if (not(old_type_->flags() & DT_FLAG_DERIVED)) {
-      if(op!=MPI_OP_NULL)
-        op->apply( contiguous_buf_char, noncontiguous_buf_char, &block_length_, old_type_);
-    }else
-      old_type_->unserialize( contiguous_buf_char, noncontiguous_buf_char, block_length_, op);
+    old_type_->unserialize( contiguous_buf_char, noncontiguous_buf_char, block_length_, op);
     contiguous_buf_char += block_length_*old_type_->size();
     if((i+1)%block_count_ ==0)
       noncontiguous_buf_char += block_length_*old_type_->size();
@@ -85,6 +100,12 @@ void Type_Hvector::unserialize( void* contiguous_buf, void *noncontiguous_buf,
   }
 }
 
+void Type_Hvector::flatten(std::vector<Segment>& segments, MPI_Aint offset)
+{
+  for (int i = 0; i < block_count_ && segments.size() <= max_segments; i++)
+    flatten_block(segments, offset + i * block_stride_, block_length_, old_type_);
+}
+
 Type_Vector::Type_Vector(int size, MPI_Aint lb, MPI_Aint ub, int flags, int count, int block_length, int stride,
                          MPI_Datatype old_type)
     : Type_Hvector(size, lb, ub, flags, count, block_length, stride * old_type->get_extent(), old_type)
@@ -128,6 +149,8 @@ Type_Hindexed::~Type_Hindexed()
 
 void Type_Hindexed::serialize( void* noncontiguous_buf, void *contiguous_buf,
                 int count){
+  if (serialize_segments(noncontiguous_buf, contiguous_buf, count))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf)+ block_indices_[0];
   for (int j = 0; j < count; j++) {
@@ -149,6 +172,8 @@ void Type_Hindexed::serialize( void* noncontiguous_buf, void *contiguous_buf,
 
 void Type_Hindexed::unserialize( void* contiguous_buf, void *noncontiguous_buf,
                           int count, MPI_Op op){
+  if (unserialize_segments(contiguous_buf, noncontiguous_buf, count, op))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf)+ block_indices_[0];
   for (int j = 0; j < count; j++) {
@@ -170,6 +195,12 @@ void Type_Hindexed::unserialize( void* contiguous_buf, void *noncontiguous_buf,
   }
 }
 
+void Type_Hindexed::flatten(std::vector<Segment>& segments, MPI_Aint offset)
+{
+  for (int i = 0; i < block_count_ && segments.size() <= max_segments; i++)
+    flatten_block(segments, offset + block_indices_[i], block_lengths_[i], old_type_);
+}
+
 Type_Indexed::Type_Indexed(int size, MPI_Aint lb, MPI_Aint ub, int flags, int count, int* block_lengths,
                            int* block_indices, MPI_Datatype old_type)
     : Type_Hindexed(size, lb, ub, flags, count, block_lengths, block_indices, old_type, old_type->get_extent())
@@ -202,6 +233,8 @@ Type_Struct::~Type_Struct(){
 
 void Type_Struct::serialize( void* noncontiguous_buf, void *contiguous_buf,
                         int count){
+  if (serialize_segments(noncontiguous_buf, contiguous_buf, count))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf)+ block_indices_[0];
   for (int j = 0; j < count; j++) {
@@ -224,6 +257,8 @@ void Type_Struct::serialize( void* noncontiguous_buf, void *contiguous_buf,
 
 void Type_Struct::unserialize( void* contiguous_buf, void *noncontiguous_buf,
                               int count, MPI_Op op){
+  if (unserialize_segments(contiguous_buf, noncontiguous_buf, count, op))
+    return;
   char* contiguous_buf_char = static_cast<char*>(contiguous_buf);
   char* noncontiguous_buf_char = static_cast<char*>(noncontiguous_buf)+ block_indices_[0];
   for (int j = 0; j < count; j++) {
@@ -244,5 +279,11 @@ void Type_Struct::unserialize( void* contiguous_buf, void *noncontiguous_buf,
   }
 }
 
+void Type_Struct::flatten(std::vector<Segment>& segments, MPI_Aint offset)
+{
+  for (int i = 0; i < block_count_ && segments.size() <= max_segments; i++)
+    flatten_block(segments, offset + block_indices_[i], block_lengths_[i], old_types_[i]);
+}
+
 }
 }
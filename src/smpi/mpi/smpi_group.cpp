@@ -6,6 +6,7 @@
 #include "simgrid/s4u/Actor.hpp"
 #include "smpi_group.hpp"
 #include "smpi_comm.hpp"
+#include <cstdint>
 #include <string>
 #include <xbt/log.h>
 
@@ -21,39 +22,90 @@ Group::Group(Group* origin)
 {
   if (origin != MPI_GROUP_NULL && origin != MPI_GROUP_EMPTY) {
     size_              = origin->size();
-    // FIXME: cheinrich: There is no such thing as an index any more; the two maps should be removed
-    index_to_rank_map_ = origin->index_to_rank_map_;
     rank_to_actor_map_ = origin->rank_to_actor_map_;
-    actor_to_rank_map_ = origin->actor_to_rank_map_;
+    first_rank_        = origin->first_rank_;
+    first_pid_         = origin->first_pid_;
+    pid_stride_        = origin->pid_stride_;
+    pid_to_rank_       = origin->pid_to_rank_;
+    hash_shift_        = origin->hash_shift_;
   }
 }
 
 void Group::set_mapping(s4u::ActorPtr actor, int rank)
 {
-  if (0 <= rank && rank < size_) {
-    int index                = actor->get_pid();
-    if (index != MPI_UNDEFINED) {
-      if ((unsigned)index >= index_to_rank_map_.size())
-        index_to_rank_map_.resize(index + 1, MPI_UNDEFINED);
-      index_to_rank_map_[index] = rank;
-    }
+  if (0 <= rank && rank < size_ && actor != nullptr) {
+    aid_t pid     = actor->get_pid();
+    bool remapped = (rank_to_actor_map_[rank] != nullptr);
 
     rank_to_actor_map_[rank] = actor;
-    if (actor != nullptr) {
-      actor_to_rank_map_.insert({actor, rank});
+    if (remapped) { // The previous actor of this rank has to leave the index
+      hash_all_ranks();
+    } else if (not pid_to_rank_.empty()) {
+      hash_insert(pid, rank);
+    } else if (first_rank_ == MPI_UNDEFINED) {
+      first_rank_ = rank;
+      first_pid_  = pid;
+    } else if (pid_stride_ == 0 && pid != first_pid_ && (pid - first_pid_) % (rank - first_rank_) == 0) {
+      pid_stride_ = (pid - first_pid_) / (rank - first_rank_);
+    } else if (pid_stride_ == 0 || pid != first_pid_ + (rank - first_rank_) * pid_stride_) {
+      hash_all_ranks(); // Not a progression
     }
   }
 }
 
-int Group::rank(int index)
+/** Fibonacci hashing, taking the high bits of the product to spread the PIDs that are a multiple of a power of 2 */
+static inline size_t hash_slot(aid_t pid, int shift)
 {
-  int rank;
-  if (0 <= index && (unsigned)index < index_to_rank_map_.size())
-    rank = index_to_rank_map_[index];
-  else
-    rank = MPI_UNDEFINED;
+  return static_cast<size_t>((static_cast<uint64_t>(pid) * 0x9E3779B97F4A7C15ULL) >> shift);
+}
+
+void Group::hash_insert(aid_t pid, int rank)
+{
+  size_t mask = pid_to_rank_.size() - 1;
+  size_t slot = hash_slot(pid, hash_shift_);
+  while (pid_to_rank_[slot].second != MPI_UNDEFINED) {
+    if (pid_to_rank_[slot].first == pid) // An actor twice in the group: keep its first rank
+      return;
+    slot = (slot + 1) & mask;
+  }
+  pid_to_rank_[slot] = {pid, rank};
+}
+
+/** Indexes all the mapped ranks in a hash table that is at most half full, whatever the number of ranks mapped later */
+void Group::hash_all_ranks()
+{
+  int bits = 1;
+  while ((1 << bits) < 2 * size_)
+    bits++;
+  hash_shift_ = 64 - bits;
+  pid_to_rank_.assign(size_t(1) << bits, {0, MPI_UNDEFINED});
+  for (int rank = 0; rank < size_; rank++)
+    if (rank_to_actor_map_[rank] != nullptr)
+      hash_insert(rank_to_actor_map_[rank]->get_pid(), rank);
+}
+
+int Group::rank(aid_t pid)
+{
+  if (pid_to_rank_.empty()) {
+    if (first_rank_ == MPI_UNDEFINED)
+      return MPI_UNDEFINED;
+    if (pid_stride_ == 0)
+      return pid == first_pid_ ? first_rank_ : MPI_UNDEFINED;
+    aid_t delta = pid - first_pid_;
+    if (delta % pid_stride_ != 0)
+      return MPI_UNDEFINED;
+    aid_t rank = first_rank_ + delta / pid_stride_;
+    // The progression may not be complete yet, while the actors are being mapped
+    if (rank < 0 || rank >= size_ || rank_to_actor_map_[rank] == nullptr)
+      return MPI_UNDEFINED;
+    return static_cast<int>(rank);
+  }
 
-  return rank;
+  size_t mask = pid_to_rank_.size() - 1;
+  for (size_t slot = hash_slot(pid, hash_shift_); pid_to_rank_[slot].second != MPI_UNDEFINED; slot = (slot + 1) & mask)
+    if (pid_to_rank_[slot].first == pid)
+      return pid_to_rank_[slot].second;
+  return MPI_UNDEFINED;
 }
 
 s4u::ActorPtr Group::actor(int rank)
@@ -66,8 +118,7 @@ s4u::ActorPtr Group::actor(int rank)
 
 int Group::rank(const s4u::ActorPtr actor)
 {
-  auto iterator = actor_to_rank_map_.find(actor);
-  return (iterator == actor_to_rank_map_.end()) ? MPI_UNDEFINED : (*iterator).second;
+  return actor == nullptr ? MPI_UNDEFINED : rank(actor->get_pid());
 }
 
 void Group::ref()
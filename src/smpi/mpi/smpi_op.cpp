@@ -10,181 +10,237 @@
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(smpi_op, smpi, "Logging specific to SMPI (op)");
 
-#define MAX_OP(a, b)  (b) = (a) < (b) ? (b) : (a)
-#define MIN_OP(a, b)  (b) = (a) < (b) ? (a) : (b)
-#define SUM_OP(a, b)  (b) += (a)
-#define PROD_OP(a, b) (b) *= (a)
-#define LAND_OP(a, b) (b) = (a) && (b)
-#define LOR_OP(a, b)  (b) = (a) || (b)
-#define LXOR_OP(a, b) (b) = (not(a) && (b)) || ((a) && not(b))
-#define BAND_OP(a, b) (b) &= (a)
-#define BOR_OP(a, b)  (b) |= (a)
-#define BXOR_OP(a, b) (b) ^= (a)
-#define MAXLOC_OP(a, b)  (b) = (a.value) < (b.value) ? (b) : ((a.value) == (b.value) ? ((a.index) < (b.index) ? (a) : (b)) : (a))
-#define MINLOC_OP(a, b)  (b) = (a.value) < (b.value) ? (a) : ((a.value) == (b.value) ? ((a.index) < (b.index) ? (a) : (b)) : (b))
-
-#define APPLY_FUNC(a, b, length, type, func) \
-{                                          \
-  int i;                                   \
-  type* x = (type*)(a);                    \
-  type* y = (type*)(b);                    \
-  for(i = 0; i < *(length); i++) {         \
-    func(x[i], y[i]);                      \
-  }                                        \
+/* The predefined operations are applied by loops specialized for each operation and C type, that the compiler can
+ * vectorize. With GCC on x86, they are compiled both for AVX2 and for the baseline instruction set, and the best
+ * version is selected when the library is loaded. */
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__)) && defined(__linux__)
+#define SMPI_OP_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define SMPI_OP_KERNEL
+#endif
+
+namespace {
+template <class T> struct max_op {
+  static T apply(T a, T b) { return a < b ? b : a; }
+};
+template <class T> struct min_op {
+  static T apply(T a, T b) { return a < b ? a : b; }
+};
+template <class T> struct sum_op {
+  static T apply(T a, T b) { return b + a; }
+};
+template <class T> struct prod_op {
+  static T apply(T a, T b) { return b * a; }
+};
+template <class T> struct land_op {
+  static T apply(T a, T b) { return a && b; }
+};
+template <class T> struct lor_op {
+  static T apply(T a, T b) { return a || b; }
+};
+template <class T> struct lxor_op {
+  static T apply(T a, T b) { return (not a && b) || (a && not b); }
+};
+template <class T> struct band_op {
+  static T apply(T a, T b) { return b & a; }
+};
+template <class T> struct bor_op {
+  static T apply(T a, T b) { return b | a; }
+};
+template <class T> struct bxor_op {
+  static T apply(T a, T b) { return b ^ a; }
+};
+template <class T> struct maxloc_op {
+  static T apply(T a, T b)
+  {
+    return a.value < b.value ? b : (a.value == b.value ? (a.index < b.index ? a : b) : a);
+  }
+};
+template <class T> struct minloc_op {
+  static T apply(T a, T b)
+  {
+    return a.value < b.value ? a : (a.value == b.value ? (a.index < b.index ? a : b) : b);
+  }
+};
+
+template <size_t N> void copy_kernel(const void* invec, void* inoutvec, int len)
+{
+  memcpy(inoutvec, invec, len * N);
 }
 
-#define APPLY_OP_LOOP(dtype, type, op) \
-  if (*datatype == dtype) {\
-    APPLY_FUNC(a, b, length, type, op)\
-  } else \
-
-
-#define APPLY_BASIC_OP_LOOP(op)\
-APPLY_OP_LOOP(MPI_CHAR, char,op)\
-APPLY_OP_LOOP(MPI_SHORT, short,op)\
-APPLY_OP_LOOP(MPI_INT, int,op)\
-APPLY_OP_LOOP(MPI_LONG, long,op)\
-APPLY_OP_LOOP(MPI_LONG_LONG, long long,op)\
-APPLY_OP_LOOP(MPI_SIGNED_CHAR, signed char,op)\
-APPLY_OP_LOOP(MPI_UNSIGNED_CHAR, unsigned char,op)\
-APPLY_OP_LOOP(MPI_UNSIGNED_SHORT, unsigned short,op)\
-APPLY_OP_LOOP(MPI_UNSIGNED, unsigned int,op)\
-APPLY_OP_LOOP(MPI_UNSIGNED_LONG, unsigned long,op)\
-APPLY_OP_LOOP(MPI_UNSIGNED_LONG_LONG, unsigned long long,op)\
-APPLY_OP_LOOP(MPI_WCHAR, wchar_t,op)\
-APPLY_OP_LOOP(MPI_BYTE, int8_t,op)\
-APPLY_OP_LOOP(MPI_INT8_T, int8_t,op)\
-APPLY_OP_LOOP(MPI_INT16_T, int16_t,op)\
-APPLY_OP_LOOP(MPI_INT32_T, int32_t,op)\
-APPLY_OP_LOOP(MPI_INT64_T, int64_t,op)\
-APPLY_OP_LOOP(MPI_UINT8_T, uint8_t,op)\
-APPLY_OP_LOOP(MPI_UINT16_T, uint16_t,op)\
-APPLY_OP_LOOP(MPI_UINT32_T, uint32_t,op)\
-APPLY_OP_LOOP(MPI_UINT64_T, uint64_t,op)\
-APPLY_OP_LOOP(MPI_AINT, MPI_Aint,op)\
-APPLY_OP_LOOP(MPI_OFFSET, MPI_Offset,op)\
-APPLY_OP_LOOP(MPI_INTEGER1, int,op)\
-APPLY_OP_LOOP(MPI_INTEGER2, int16_t,op)\
-APPLY_OP_LOOP(MPI_INTEGER4, int32_t,op)\
-APPLY_OP_LOOP(MPI_INTEGER8, int64_t,op)\
-APPLY_OP_LOOP(MPI_COUNT, long long,op)
-
-
-#define APPLY_BOOL_OP_LOOP(op)\
-APPLY_OP_LOOP(MPI_C_BOOL, bool,op)
-
-#define APPLY_FLOAT_OP_LOOP(op)\
-APPLY_OP_LOOP(MPI_FLOAT, float,op)\
-APPLY_OP_LOOP(MPI_DOUBLE, double,op)\
-APPLY_OP_LOOP(MPI_LONG_DOUBLE, long double,op)\
-APPLY_OP_LOOP(MPI_REAL, float,op)\
-APPLY_OP_LOOP(MPI_REAL4, float,op)\
-APPLY_OP_LOOP(MPI_REAL8, double,op)\
-APPLY_OP_LOOP(MPI_REAL16, long double,op)
-
-#define APPLY_COMPLEX_OP_LOOP(op)\
-APPLY_OP_LOOP(MPI_C_FLOAT_COMPLEX, float _Complex,op)\
-APPLY_OP_LOOP(MPI_C_DOUBLE_COMPLEX, double _Complex,op)\
-APPLY_OP_LOOP(MPI_C_LONG_DOUBLE_COMPLEX, long double _Complex,op)
-
-#define APPLY_PAIR_OP_LOOP(op)\
-APPLY_OP_LOOP(MPI_FLOAT_INT, float_int,op)\
-APPLY_OP_LOOP(MPI_LONG_INT, long_int,op)\
-APPLY_OP_LOOP(MPI_DOUBLE_INT, double_int,op)\
-APPLY_OP_LOOP(MPI_SHORT_INT, short_int,op)\
-APPLY_OP_LOOP(MPI_2INT, int_int,op)\
-APPLY_OP_LOOP(MPI_2FLOAT, float_float,op)\
-APPLY_OP_LOOP(MPI_2DOUBLE, double_double,op)\
-APPLY_OP_LOOP(MPI_LONG_DOUBLE_INT, long_double_int,op)\
-APPLY_OP_LOOP(MPI_2LONG, long_long,op)
-
-#define APPLY_END_OP_LOOP(op)\
-  {\
-    xbt_die("Failed to apply " #op " to type %s", (*datatype)->name());\
-  }
+template <class T, template <class> class F>
+SMPI_OP_KERNEL void reduction_kernel(const void* invec, void* inoutvec, int len)
+{
+  const T* in = static_cast<const T*>(invec);
+  T* inout    = static_cast<T*>(inoutvec);
+  for (int i = 0; i < len; i++)
+    inout[i] = F<T>::apply(in[i], inout[i]);
+}
+} // namespace
+
+#define KERNEL_FOR(dtype, type, op)                                                                                    \
+  if (datatype == (dtype))                                                                                             \
+    return &reduction_kernel<type, op>;
+
+#define BASIC_KERNELS(op)                                                                                              \
+  KERNEL_FOR(MPI_CHAR, char, op)                                                                                       \
+  KERNEL_FOR(MPI_SHORT, short, op)                                                                                     \
+  KERNEL_FOR(MPI_INT, int, op)                                                                                         \
+  KERNEL_FOR(MPI_LONG, long, op)                                                                                       \
+  KERNEL_FOR(MPI_LONG_LONG, long long, op)                                                                             \
+  KERNEL_FOR(MPI_SIGNED_CHAR, signed char, op)                                                                         \
+  KERNEL_FOR(MPI_UNSIGNED_CHAR, unsigned char, op)                                                                     \
+  KERNEL_FOR(MPI_UNSIGNED_SHORT, unsigned short, op)                                                                   \
+  KERNEL_FOR(MPI_UNSIGNED, unsigned int, op)                                                                           \
+  KERNEL_FOR(MPI_UNSIGNED_LONG, unsigned long, op)                                                                     \
+  KERNEL_FOR(MPI_UNSIGNED_LONG_LONG, unsigned long long, op)                                                           \
+  KERNEL_FOR(MPI_WCHAR, wchar_t, op)                                                                                   \
+  KERNEL_FOR(MPI_BYTE, int8_t, op)                                                                                     \
+  KERNEL_FOR(MPI_INT8_T, int8_t, op)                                                                                   \
+  KERNEL_FOR(MPI_INT16_T, int16_t, op)                                                                                 \
+  KERNEL_FOR(MPI_INT32_T, int32_t, op)                                                                                 \
+  KERNEL_FOR(MPI_INT64_T, int64_t, op)                                                                                 \
+  KERNEL_FOR(MPI_UINT8_T, uint8_t, op)                                                                                 \
+  KERNEL_FOR(MPI_UINT16_T, uint16_t, op)                                                                               \
+  KERNEL_FOR(MPI_UINT32_T, uint32_t, op)                                                                               \
+  KERNEL_FOR(MPI_UINT64_T, uint64_t, op)                                                                               \
+  KERNEL_FOR(MPI_AINT, MPI_Aint, op)                                                                                   \
+  KERNEL_FOR(MPI_OFFSET, MPI_Offset, op)                                                                               \
+  KERNEL_FOR(MPI_INTEGER1, int, op)                                                                                    \
+  KERNEL_FOR(MPI_INTEGER2, int16_t, op)                                                                                \
+  KERNEL_FOR(MPI_INTEGER4, int32_t, op)                                                                                \
+  KERNEL_FOR(MPI_INTEGER8, int64_t, op)                                                                                \
+  KERNEL_FOR(MPI_COUNT, long long, op)
+
+#define BOOL_KERNELS(op) KERNEL_FOR(MPI_C_BOOL, bool, op)
+
+#define FLOAT_KERNELS(op)                                                                                              \
+  KERNEL_FOR(MPI_FLOAT, float, op)                                                                                     \
+  KERNEL_FOR(MPI_DOUBLE, double, op)                                                                                   \
+  KERNEL_FOR(MPI_LONG_DOUBLE, long double, op)                                                                         \
+  KERNEL_FOR(MPI_REAL, float, op)                                                                                      \
+  KERNEL_FOR(MPI_REAL4, float, op)                                                                                     \
+  KERNEL_FOR(MPI_REAL8, double, op)                                                                                    \
+  KERNEL_FOR(MPI_REAL16, long double, op)
+
+#define COMPLEX_KERNELS(op)                                                                                            \
+  KERNEL_FOR(MPI_C_FLOAT_COMPLEX, float _Complex, op)                                                                  \
+  KERNEL_FOR(MPI_C_DOUBLE_COMPLEX, double _Complex, op)                                                                \
+  KERNEL_FOR(MPI_C_LONG_DOUBLE_COMPLEX, long double _Complex, op)
+
+#define PAIR_KERNELS(op)                                                                                               \
+  KERNEL_FOR(MPI_FLOAT_INT, float_int, op)                                                                             \
+  KERNEL_FOR(MPI_LONG_INT, long_int, op)                                                                               \
+  KERNEL_FOR(MPI_DOUBLE_INT, double_int, op)                                                                           \
+  KERNEL_FOR(MPI_SHORT_INT, short_int, op)                                                                             \
+  KERNEL_FOR(MPI_2INT, int_int, op)                                                                                    \
+  KERNEL_FOR(MPI_2FLOAT, float_float, op)                                                                              \
+  KERNEL_FOR(MPI_2DOUBLE, double_double, op)                                                                           \
+  KERNEL_FOR(MPI_LONG_DOUBLE_INT, long_double_int, op)                                                                 \
+  KERNEL_FOR(MPI_2LONG, long_long, op)
+
+static SMPI_Op::Kernel max_kernel(MPI_Datatype datatype)
+{
+  BASIC_KERNELS(max_op)
+  FLOAT_KERNELS(max_op)
+  return nullptr;
+}
 
-static void max_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel min_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(MAX_OP)
-  APPLY_FLOAT_OP_LOOP(MAX_OP)
-  APPLY_END_OP_LOOP(MAX_OP)
+  BASIC_KERNELS(min_op)
+  FLOAT_KERNELS(min_op)
+  return nullptr;
 }
 
-static void min_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel sum_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(MIN_OP)
-  APPLY_FLOAT_OP_LOOP(MIN_OP)
-  APPLY_END_OP_LOOP(MIN_OP)
+  BASIC_KERNELS(sum_op)
+  FLOAT_KERNELS(sum_op)
+  COMPLEX_KERNELS(sum_op)
+  return nullptr;
 }
 
-static void sum_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel prod_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(SUM_OP)
-  APPLY_FLOAT_OP_LOOP(SUM_OP)
-  APPLY_COMPLEX_OP_LOOP(SUM_OP)
-  APPLY_END_OP_LOOP(SUM_OP)
+  BASIC_KERNELS(prod_op)
+  FLOAT_KERNELS(prod_op)
+  COMPLEX_KERNELS(prod_op)
+  return nullptr;
 }
 
-static void prod_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel land_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(PROD_OP)
-  APPLY_FLOAT_OP_LOOP(PROD_OP)
-  APPLY_COMPLEX_OP_LOOP(PROD_OP)
-  APPLY_END_OP_LOOP(PROD_OP)
+  BASIC_KERNELS(land_op)
+  BOOL_KERNELS(land_op)
+  return nullptr;
 }
 
-static void land_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel lor_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(LAND_OP)
-  APPLY_BOOL_OP_LOOP(LAND_OP)
-  APPLY_END_OP_LOOP(LAND_OP)
+  BASIC_KERNELS(lor_op)
+  BOOL_KERNELS(lor_op)
+  return nullptr;
 }
 
-static void lor_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel lxor_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(LOR_OP)
-  APPLY_BOOL_OP_LOOP(LOR_OP)
-  APPLY_END_OP_LOOP(LOR_OP)
+  BASIC_KERNELS(lxor_op)
+  BOOL_KERNELS(lxor_op)
+  return nullptr;
 }
 
-static void lxor_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel band_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(LXOR_OP)
-  APPLY_BOOL_OP_LOOP(LXOR_OP)
-  APPLY_END_OP_LOOP(LXOR_OP)
+  BASIC_KERNELS(band_op)
+  BOOL_KERNELS(band_op)
+  return nullptr;
 }
 
-static void band_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel bor_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(BAND_OP)
-  APPLY_BOOL_OP_LOOP(BAND_OP)
-  APPLY_END_OP_LOOP(BAND_OP)
+  BASIC_KERNELS(bor_op)
+  BOOL_KERNELS(bor_op)
+  return nullptr;
 }
 
-static void bor_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel bxor_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(BOR_OP)
-  APPLY_BOOL_OP_LOOP(BOR_OP)
-  APPLY_END_OP_LOOP(BOR_OP)
+  BASIC_KERNELS(bxor_op)
+  BOOL_KERNELS(bxor_op)
+  return nullptr;
 }
 
-static void bxor_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel minloc_kernel(MPI_Datatype datatype)
 {
-  APPLY_BASIC_OP_LOOP(BXOR_OP)
-  APPLY_BOOL_OP_LOOP(BXOR_OP)
-  APPLY_END_OP_LOOP(BXOR_OP)
+  PAIR_KERNELS(minloc_op)
+  return nullptr;
 }
 
-static void minloc_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel maxloc_kernel(MPI_Datatype datatype)
 {
-  APPLY_PAIR_OP_LOOP(MINLOC_OP)
-  APPLY_END_OP_LOOP(MINLOC_OP)
+  PAIR_KERNELS(maxloc_op)
+  return nullptr;
 }
 
-static void maxloc_func(void *a, void *b, int *length, MPI_Datatype * datatype)
+static SMPI_Op::Kernel replace_kernel(MPI_Datatype datatype)
 {
-  APPLY_PAIR_OP_LOOP(MAXLOC_OP)
-  APPLY_END_OP_LOOP(MAXLOC_OP)
+  if (datatype->flags() & DT_FLAG_DERIVED)
+    return nullptr;
+  switch (datatype->size()) {
+    case 1:
+      return &copy_kernel<1>;
+    case 2:
+      return &copy_kernel<2>;
+    case 4:
+      return &copy_kernel<4>;
+    case 8:
+      return &copy_kernel<8>;
+    case 16:
+      return &copy_kernel<16>;
+    default:
+      return nullptr;
+  }
 }
 
 static void replace_func(void *a, void *b, int *length, MPI_Datatype * datatype)
@@ -201,19 +257,31 @@ static void no_func(void*, void*, int*, MPI_Datatype*)
   static SMPI_Op mpi_##name (&(func) /* func */, true, true ); \
 MPI_Op name = &mpi_##name;
 
-CREATE_MPI_OP(MPI_MAX, max_func);
-CREATE_MPI_OP(MPI_MIN, min_func);
-CREATE_MPI_OP(MPI_SUM, sum_func);
-CREATE_MPI_OP(MPI_PROD, prod_func);
-CREATE_MPI_OP(MPI_LAND, land_func);
-CREATE_MPI_OP(MPI_LOR, lor_func);
-CREATE_MPI_OP(MPI_LXOR, lxor_func);
-CREATE_MPI_OP(MPI_BAND, band_func);
-CREATE_MPI_OP(MPI_BOR, bor_func);
-CREATE_MPI_OP(MPI_BXOR, bxor_func);
-CREATE_MPI_OP(MPI_MAXLOC, maxloc_func);
-CREATE_MPI_OP(MPI_MINLOC, minloc_func);
-CREATE_MPI_OP(MPI_REPLACE, replace_func);
+#define CREATE_MPI_KERNEL_OP(op, kernel)                                                                               \
+  static void op##_func(void* a, void* b, int* length, MPI_Datatype* datatype)                                         \
+  {                                                                                                                    \
+    SMPI_Op::Kernel k = kernel(*datatype);                                                                             \
+    if (k == nullptr)                                                                                                  \
+      xbt_die("Failed to apply " #op " to type %s", (*datatype)->name());                                              \
+    k(a, b, *length);                                                                                                  \
+  }                                                                                                                    \
+  static SMPI_Op mpi_##op(&op##_func, true, true, &kernel);                                                            \
+  MPI_Op op = &mpi_##op;
+
+CREATE_MPI_KERNEL_OP(MPI_MAX, max_kernel);
+CREATE_MPI_KERNEL_OP(MPI_MIN, min_kernel);
+CREATE_MPI_KERNEL_OP(MPI_SUM, sum_kernel);
+CREATE_MPI_KERNEL_OP(MPI_PROD, prod_kernel);
+CREATE_MPI_KERNEL_OP(MPI_LAND, land_kernel);
+CREATE_MPI_KERNEL_OP(MPI_LOR, lor_kernel);
+CREATE_MPI_KERNEL_OP(MPI_LXOR, lxor_kernel);
+CREATE_MPI_KERNEL_OP(MPI_BAND, band_kernel);
+CREATE_MPI_KERNEL_OP(MPI_BOR, bor_kernel);
+CREATE_MPI_KERNEL_OP(MPI_BXOR, bxor_kernel);
+CREATE_MPI_KERNEL_OP(MPI_MAXLOC, maxloc_kernel);
+CREATE_MPI_KERNEL_OP(MPI_MINLOC, minloc_kernel);
+static SMPI_Op mpi_MPI_REPLACE(&replace_func, true, true, &replace_kernel);
+MPI_Op MPI_REPLACE = &mpi_MPI_REPLACE;
 CREATE_MPI_OP(MPI_NO_OP, no_func);
 
 namespace simgrid{
@@ -240,6 +308,27 @@ void Op::apply(void *invec, void *inoutvec, int *len, MPI_Datatype datatype)
   }
 }
 
+void Op::apply_strided(void* invec, void* inoutvec, int count, int len, MPI_Aint stride, MPI_Datatype datatype)
+{
+  Kernel kernel = (find_kernel_ != nullptr && not is_fortran_op_) ? find_kernel_(datatype) : nullptr;
+  if (kernel == nullptr) { // user defined operation, or error
+    for (int i = 0; i < count; i++)
+      apply(static_cast<char*>(invec) + i * len * datatype->size(), static_cast<char*>(inoutvec) + i * stride, &len,
+            datatype);
+    return;
+  }
+
+  if (smpi_privatize_global_variables == SmpiPrivStrategies::MMAP) {
+    XBT_DEBUG("Applying operation, switch to the right data frame ");
+    smpi_switch_data_segment(simgrid::s4u::Actor::self());
+  }
+  if (smpi_process()->replaying() || len <= 0)
+    return;
+  size_t block_size = len * datatype->size();
+  for (int i = 0; i < count; i++)
+    kernel(static_cast<char*>(invec) + i * block_size, static_cast<char*>(inoutvec) + i * stride, len);
+}
+
 Op* Op::f2c(int id){
   return static_cast<Op*>(F2C::f2c(id));
 }
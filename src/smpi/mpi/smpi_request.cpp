@@ -163,6 +163,16 @@ int Request::match_send(void* a, void* b, simgrid::kernel::activity::CommImpl*)
     return 0;
 }
 
+/** Key under which the requests are indexed in the mailboxes (see smpi/indexed-matching). Wildcards have no key */
+bool Request::match_key(void* data, uint64_t* key)
+{
+  MPI_Request req = static_cast<MPI_Request>(data);
+  if (req->src_ == MPI_ANY_SOURCE || req->tag_ == MPI_ANY_TAG)
+    return false;
+  *key = (static_cast<uint64_t>(static_cast<uint32_t>(req->src_)) << 32) | static_cast<uint32_t>(req->tag_);
+  return true;
+}
+
 void Request::print_request(const char *message)
 {
   XBT_VERB("%s  request %p  [buf = %p, size = %zu, src = %d, dst = %d, tag = %d, flags = %x]",
@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "cpu_interface.hpp"
+#include "src/include/xbt/slab.hpp"
 #include "xbt/base.h"
 
 /***********
@@ -56,7 +57,7 @@ protected:
 /**********
  * Action *
  **********/
-class CpuCas01Action : public CpuAction {
+class CpuCas01Action : public CpuAction, public xbt::Pooled<CpuCas01Action> {
   friend CpuAction* CpuCas01::execution_start(double size);
   friend CpuAction* CpuCas01::sleep(double duration);
 
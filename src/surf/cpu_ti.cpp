@@ -26,10 +26,10 @@ CpuTiProfile::CpuTiProfile(profile::Profile* profile)
 {
   double integral = 0;
   double time = 0;
-  unsigned nb_points = profile->event_list.size() + 1;
+  unsigned nb_points = profile->get_events().size() + 1;
   time_points_.reserve(nb_points);
   integral_.reserve(nb_points);
-  for (auto const& val : profile->event_list) {
+  for (auto const& val : profile->get_events()) {
     time_points_.push_back(time);
     integral_.push_back(integral);
     time += val.date_;
@@ -203,7 +203,7 @@ double CpuTiTmgr::get_power_scale(double a)
 {
   double reduced_a          = a - floor(a / last_time_) * last_time_;
   int point                       = CpuTiProfile::binary_search(profile_->time_points_, reduced_a);
-  kernel::profile::DatedValue val = speed_profile_->event_list.at(point);
+  kernel::profile::DatedValue val = speed_profile_->get_events()[point];
   return val.value_;
 }
 
@@ -228,16 +228,16 @@ CpuTiTmgr::CpuTiTmgr(kernel::profile::Profile* speed_profile, double value) : sp
   }
 
   /* only one point available, fixed trace */
-  if (speed_profile->event_list.size() == 1) {
+  if (speed_profile->get_events().size() == 1) {
     type_  = Type::FIXED;
-    value_ = speed_profile->event_list.front().value_;
+    value_ = speed_profile->get_events().front().value_;
     return;
   }
 
   type_ = Type::DYNAMIC;
 
   /* count the total time of trace file */
-  for (auto const& val : speed_profile->event_list)
+  for (auto const& val : speed_profile->get_events())
     total_time += val.date_;
 
   profile_.reset(new CpuTiProfile(speed_profile));
@@ -346,8 +346,8 @@ void CpuTi::set_speed_profile(kernel::profile::Profile* profile)
   speed_integrated_trace_ = new CpuTiTmgr(profile, speed_.scale);
 
   /* add a fake trace event if periodicity == 0 */
-  if (profile && profile->event_list.size() > 1) {
-    kernel::profile::DatedValue val = profile->event_list.back();
+  if (profile && profile->get_events().size() > 1) {
+    kernel::profile::DatedValue val = profile->get_events().back();
     if (val.date_ < 1e-12) {
       simgrid::kernel::profile::Profile* prof = new simgrid::kernel::profile::Profile();
       speed_.event                            = prof->schedule(&future_evt_set, this);
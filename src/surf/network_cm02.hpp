@@ -9,6 +9,7 @@
 #include <xbt/base.h>
 
 #include "network_interface.hpp"
+#include "src/include/xbt/slab.hpp"
 #include "xbt/graph.h"
 
 
@@ -56,7 +57,7 @@ public:
 /**********
  * Action *
  **********/
-class NetworkCm02Action : public NetworkAction {
+class NetworkCm02Action : public NetworkAction, public xbt::Pooled<NetworkCm02Action> {
   friend Action* NetworkCm02Model::communicate(s4u::Host* src, s4u::Host* dst, double size, double rate);
 
 public:
@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "network_interface.hpp"
+#include "simgrid/kernel/routing/NetZoneImpl.hpp"
 #include "simgrid/s4u/Engine.hpp"
 #include "simgrid/sg_config.hpp"
 #include "src/surf/surf_interface.hpp"
@@ -100,6 +101,7 @@ void LinkImpl::destroy()
   if (not currently_destroying_) {
     currently_destroying_ = true;
     s4u::Link::on_destruction(this->piface_);
+    routing::NetZoneImpl::clear_route_cache();
     delete this;
   }
 }
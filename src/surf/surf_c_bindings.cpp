@@ -21,19 +21,18 @@ extern double NOW;
 void surf_presolve()
 {
   double next_event_date = -1.0;
-  simgrid::kernel::profile::Event* event        = nullptr;
-  double value = -1.0;
-  simgrid::kernel::resource::Resource* resource = nullptr;
+  std::vector<simgrid::kernel::profile::FiredEvent> events;
 
   XBT_DEBUG ("Consume all trace events occurring before the starting time.");
   while ((next_event_date = future_evt_set.next_date()) != -1.0) {
     if (next_event_date > NOW)
       break;
 
-    while ((event = future_evt_set.pop_leq(next_event_date, &value, &resource))) {
-      if (value >= 0)
-        resource->apply_event(event, value);
-    }
+    events.clear();
+    future_evt_set.pop_all_leq(next_event_date, events);
+    for (auto const& fired : events)
+      if (fired.value >= 0)
+        fired.resource->apply_event(fired.event, fired.value);
   }
 
   XBT_DEBUG ("Set every models in the right state by updating them to 0.");
@@ -45,9 +44,7 @@ double surf_solve(double max_date)
 {
   double time_delta = -1.0; /* duration */
   double model_next_action_end = -1.0;
-  double value = -1.0;
-  simgrid::kernel::resource::Resource* resource = nullptr;
-  simgrid::kernel::profile::Event* event        = nullptr;
+  std::vector<simgrid::kernel::profile::FiredEvent> events;
 
   if (max_date > 0.0) {
     xbt_assert(max_date > NOW,"You asked to simulate up to %f, but that's in the past already", max_date);
@@ -109,7 +106,10 @@ double surf_solve(double max_date)
 
     XBT_DEBUG("Updating models (min = %g, NOW = %g, next_event_date = %g)", time_delta, NOW, next_event_date);
 
-    while ((event = future_evt_set.pop_leq(next_event_date, &value, &resource))) {
+    events.clear();
+    future_evt_set.pop_all_leq(next_event_date, events);
+    for (auto const& fired : events) {
+      simgrid::kernel::resource::Resource* resource = fired.resource;
       if (resource->is_used() || (watched_hosts.find(resource->get_cname()) != watched_hosts.end())) {
         time_delta = next_event_date - NOW;
         XBT_DEBUG("This event invalidates the next_occuring_event() computation of models. Next event set to %f", time_delta);
@@ -120,7 +120,7 @@ double surf_solve(double max_date)
       /* update state of the corresponding resource to the new value. Does not touch lmm.
          It will be modified if needed when updating actions */
       XBT_DEBUG("Calling update_resource_state for resource %s", resource->get_cname());
-      resource->apply_event(event, value);
+      resource->apply_event(fired.event, fired.value);
       NOW = round_start;
     }
   }
@@ -22,6 +22,9 @@
 XBT_PUBLIC_DATA double sg_maxmin_precision;
 XBT_PUBLIC_DATA double sg_surf_precision;
 XBT_PUBLIC_DATA int sg_concurrency_limit;
+XBT_PUBLIC_DATA int sg_maxmin_threads;
+XBT_PUBLIC_DATA int sg_maxmin_parallel_threshold;
+XBT_PUBLIC_DATA int sg_routing_threads;
 
 extern XBT_PRIVATE double sg_latency_factor;
 extern XBT_PRIVATE double sg_bandwidth_factor;
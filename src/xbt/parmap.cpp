@@ -3,6 +3,71 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include "xbt/parmap.hpp"
 #include "xbt/log.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(xbt_parmap, xbt, "parmap: parallel map");
+
+namespace simgrid {
+namespace xbt {
+
+/** Parses a list of CPUs such as "0-3,8,10-11" (as found in /sys/devices/system/node/nodeX/cpulist) */
+static void parse_cpulist(const std::string& list, std::vector<unsigned>& cpus)
+{
+  std::istringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    unsigned first;
+    unsigned last;
+    int n = sscanf(range.c_str(), "%u-%u", &first, &last);
+    if (n < 1)
+      continue;
+    if (n == 1)
+      last = first;
+    for (unsigned cpu = first; cpu <= last; cpu++)
+      cpus.push_back(cpu);
+  }
+}
+
+std::vector<unsigned> parmap_cpus()
+{
+  std::vector<unsigned> cpus;
+#ifdef __linux__
+  /* List the CPUs node after node, so that consecutive workers share their memory node as much as possible */
+  for (unsigned node = 0;; node++) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+    if (not file || not std::getline(file, list))
+      break;
+    parse_cpulist(list, cpus);
+  }
+  /* Only keep the CPUs on which we are allowed to run */
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    if (cpus.empty())
+      for (unsigned cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        cpus.push_back(cpu);
+    cpus.erase(std::remove_if(begin(cpus), end(cpus),
+                              [&allowed](unsigned cpu) { return cpu >= CPU_SETSIZE || not CPU_ISSET(cpu, &allowed); }),
+               end(cpus));
+  }
+#endif
+  if (cpus.empty()) {
+    for (unsigned cpu = 0; cpu < std::max(1U, std::thread::hardware_concurrency()); cpu++)
+      cpus.push_back(cpu);
+  }
+  XBT_DEBUG("Parmap workers will be bound to %zu CPUs", cpus.size());
+  return cpus;
+}
+} // namespace xbt
+} // namespace simgrid
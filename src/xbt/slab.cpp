@@ -0,0 +1,186 @@
+/* Slab allocators of the simulation objects                                */
+
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/include/xbt/slab.hpp"
+#include "xbt/asserts.h"
+#include "xbt/backtrace.hpp"
+#include "xbt/log.h"
+
+#include <algorithm>
+#include <memory>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(xbt_slab, xbt, "Slab allocators of the simulation objects");
+
+namespace simgrid {
+namespace xbt {
+
+namespace {
+constexpr unsigned max_allocators = 32;
+constexpr size_t batch_size       = 64; // number of blocks moved at once between a thread cache and the shared list
+constexpr size_t slab_size        = 64 * 1024;
+
+std::mutex registry_mutex;
+std::vector<SlabAllocator*>& registry()
+{
+  static auto* allocators = new std::vector<SlabAllocator*>(); // never destroyed, as the allocators themselves
+  return *allocators;
+}
+} // namespace
+
+/** The caches of the current thread, for all the allocators. They are flushed to the shared lists when it terminates. */
+class SlabAllocator::ThreadCaches {
+public:
+  Cache caches[max_allocators];
+
+  static thread_local ThreadCaches* current;
+  static thread_local bool gone; // once the thread is terminating, the blocks go directly to the shared lists
+
+  static ThreadCaches* create()
+  {
+    static thread_local std::unique_ptr<ThreadCaches> owner; // destroyed when the thread terminates
+    owner.reset(new ThreadCaches());
+    current = owner.get();
+    return current;
+  }
+  ~ThreadCaches()
+  {
+    current = nullptr;
+    gone    = true;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (unsigned id = 0; id < registry().size(); id++)
+      registry()[id]->flush(caches[id], 0);
+  }
+};
+
+thread_local SlabAllocator::ThreadCaches* SlabAllocator::ThreadCaches::current = nullptr;
+thread_local bool SlabAllocator::ThreadCaches::gone                            = false;
+
+SlabAllocator::SlabAllocator(const char* name, size_t object_size)
+    : name_(name)
+    , object_size_(object_size)
+    , block_size_((std::max(object_size, sizeof(Block)) + alignof(std::max_align_t) - 1) /
+                  alignof(std::max_align_t) * alignof(std::max_align_t))
+    , blocks_per_slab_(std::max<size_t>(2 * batch_size, slab_size / block_size_))
+{
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  id_ = registry().size();
+  xbt_assert(id_ < max_allocators, "Too many slab allocators (%u), increase max_allocators", id_ + 1);
+  registry().push_back(this);
+}
+
+SlabAllocator::Cache* SlabAllocator::get_cache()
+{
+  ThreadCaches* caches = ThreadCaches::current;
+  if (caches == nullptr) {
+    if (ThreadCaches::gone)
+      return nullptr;
+    caches = ThreadCaches::create();
+  }
+  return &caches->caches[id_];
+}
+
+/** Moves a batch of free blocks to the cache, allocating a new slab if needed */
+void SlabAllocator::refill(Cache& cache)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_list_ == nullptr) {
+    char* slab = static_cast<char*>(::operator new(blocks_per_slab_ * block_size_));
+    slabs_.push_back(slab);
+    for (size_t i = blocks_per_slab_; i-- > 0;) {
+      Block* block = reinterpret_cast<Block*>(slab + i * block_size_);
+      block->next  = free_list_;
+      free_list_   = block;
+    }
+    free_count_ += blocks_per_slab_;
+  }
+  while (free_list_ != nullptr && cache.count < batch_size) {
+    Block* block = free_list_;
+    free_list_   = block->next;
+    block->next  = cache.head;
+    cache.head   = block;
+    cache.count++;
+    free_count_--;
+  }
+}
+
+/** Gives the blocks of the cache back to the shared list, but the @a keep first ones */
+void SlabAllocator::flush(Cache& cache, size_t keep)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (cache.count > keep) {
+    Block* block = cache.head;
+    cache.head   = block->next;
+    block->next  = free_list_;
+    free_list_   = block;
+    cache.count--;
+    free_count_++;
+  }
+  allocations_ += cache.allocations;
+  cache.allocations = 0;
+}
+
+void* SlabAllocator::allocate()
+{
+  Cache* cache = get_cache();
+  if (cache == nullptr) { // late allocation in a terminating thread: go through a temporary cache
+    Cache tmp;
+    refill(tmp);
+    Block* block = tmp.head;
+    tmp.head     = block->next;
+    tmp.count--;
+    tmp.allocations++;
+    flush(tmp, 0);
+    return block;
+  }
+  if (cache->head == nullptr)
+    refill(*cache);
+  Block* block = cache->head;
+  cache->head  = block->next;
+  cache->count--;
+  cache->allocations++;
+  return block;
+}
+
+void SlabAllocator::deallocate(void* ptr)
+{
+  Block* block = static_cast<Block*>(ptr);
+  Cache* cache = get_cache();
+  if (cache == nullptr) { // late release in a terminating thread
+    std::lock_guard<std::mutex> lock(mutex_);
+    block->next = free_list_;
+    free_list_  = block;
+    free_count_++;
+    return;
+  }
+  block->next = cache->head;
+  cache->head = block;
+  cache->count++;
+  if (cache->count >= 2 * batch_size)
+    flush(*cache, batch_size);
+}
+
+void SlabAllocator::report()
+{
+  std::lock_guard<std::mutex> registry_lock(registry_mutex);
+  for (SlabAllocator* allocator : registry()) {
+    Cache* cache = allocator->get_cache();
+    std::lock_guard<std::mutex> lock(allocator->mutex_);
+    unsigned long allocations = allocator->allocations_;
+    size_t in_use             = allocator->slabs_.size() * allocator->blocks_per_slab_ - allocator->free_count_;
+    if (cache != nullptr) {
+      allocations += cache->allocations;
+      in_use -= cache->count;
+    }
+    auto name = simgrid::xbt::demangle(allocator->name_);
+    XBT_VERB("%s: %lu allocations served by %zu slabs of %zu blocks of %zu bytes (%zu kiB), %zu blocks still in use",
+             name.get(), allocations, allocator->slabs_.size(), allocator->blocks_per_slab_, allocator->block_size_,
+             allocator->slabs_.size() * allocator->blocks_per_slab_ * allocator->block_size_ / 1024, in_use);
+  }
+}
+
+} // namespace xbt
+} // namespace simgrid
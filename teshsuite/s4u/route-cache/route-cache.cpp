@@ -0,0 +1,42 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Retrieves every route of the platform several times, so that the routes given by the route cache can be compared
+ * to the ones computed with --cfg=network/route-cache:0 */
+
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this s4u test");
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc == 2, "Usage: %s platform.xml", argv[0]);
+  e.load_platform(argv[1]);
+
+  std::vector<simgrid::s4u::Host*> hosts = e.get_all_hosts();
+  std::sort(hosts.begin(), hosts.end(),
+            [](simgrid::s4u::Host* a, simgrid::s4u::Host* b) { return a->get_name() < b->get_name(); });
+
+  for (int round = 0; round < 3; round++) {
+    unsigned long link_count = 0;
+    double total_latency     = 0.0;
+    for (simgrid::s4u::Host* src : hosts)
+      for (simgrid::s4u::Host* dst : hosts) {
+        std::vector<simgrid::s4u::Link*> links;
+        double latency = 0.0;
+        src->route_to(dst, links, &latency);
+        link_count += links.size();
+        total_latency += latency;
+        if (round == 0 && src == hosts.front())
+          XBT_INFO("Route %s -> %s: %zu links, latency %g", src->get_cname(), dst->get_cname(), links.size(), latency);
+      }
+    XBT_INFO("Round %d: %zu routes, %lu links, total latency %g", round, hosts.size() * hosts.size(), link_count,
+             total_latency);
+  }
+  XBT_INFO("Route cache: %lu hits, %lu misses", e.get_route_cache_hits(), e.get_route_cache_misses());
+
+  return 0;
+}
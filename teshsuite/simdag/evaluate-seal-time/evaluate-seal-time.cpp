@@ -0,0 +1,113 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Builds a netzone of the given routing made of routers linked in a ring with random chords, and times its sealing.
+ *   evaluate-seal-time Floyd 3000 --timings --cfg=network/routing-threads:8
+ * A checksum of some routes is displayed, to compare the routing tables computed with different settings. */
+
+#include "simgrid/kernel/routing/NetPoint.hpp"
+#include "simgrid/kernel/routing/NetZoneImpl.hpp"
+#include "simgrid/s4u/Link.hpp"
+#include "simgrid/simdag.h"
+#include "src/surf/network_interface.hpp"
+#include "src/surf/xml/platf_private.hpp"
+#include "src/surf/xml/simgrid_dtd.h"
+#include "xbt/xbt_os_time.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+  SD_init(&argc, argv);
+
+  bool timings = false;
+  std::vector<const char*> args;
+  for (int i = 1; i < argc; i++) {
+    if (not strcmp(argv[i], "--timings"))
+      timings = true;
+    else
+      args.push_back(argv[i]);
+  }
+  xbt_assert(args.size() == 2, "Usage: %s Floyd|Dijkstra|DijkstraCache size [--timings]", argv[0]);
+
+  simgrid::kernel::routing::ZoneCreationArgs zone;
+  zone.id = "zone";
+  if (not strcmp(args[0], "Floyd"))
+    zone.routing = A_surfxml_AS_routing_Floyd;
+  else if (not strcmp(args[0], "Dijkstra"))
+    zone.routing = A_surfxml_AS_routing_Dijkstra;
+  else if (not strcmp(args[0], "DijkstraCache"))
+    zone.routing = A_surfxml_AS_routing_DijkstraCache;
+  else
+    xbt_die("Unknown routing '%s'", args[0]);
+  unsigned int size = std::stoul(args[1]);
+  xbt_assert(size > 1, "The zone needs at least two routers");
+
+  sg_platf_new_Zone_begin(&zone);
+  std::vector<simgrid::kernel::routing::NetPoint*> routers;
+  for (unsigned int i = 0; i < size; i++)
+    routers.push_back(sg_platf_new_router("router-" + std::to_string(i), nullptr));
+
+  /* A ring, plus a chord from every fourth router, drawn with a fixed linear congruential generator */
+  std::set<std::pair<unsigned int, unsigned int>> edges;
+  unsigned long seed = 42;
+  for (unsigned int i = 0; i < size; i++) {
+    edges.insert({std::min(i, (i + 1) % size), std::max(i, (i + 1) % size)});
+    seed              = seed * 6364136223846793005UL + 1442695040888963407UL;
+    unsigned int peer = (seed >> 33) % size;
+    if (i % 4 == 0 && peer != i)
+      edges.insert({std::min(i, peer), std::max(i, peer)});
+  }
+  std::unordered_map<simgrid::kernel::resource::LinkImpl*, unsigned int> link_ids;
+  for (auto const& edge : edges) {
+    simgrid::kernel::routing::LinkCreationArgs link;
+    link.id        = "link-" + std::to_string(link_ids.size());
+    link.bandwidth = 1e9;
+    link.latency   = 1e-4;
+    link.policy    = simgrid::s4u::Link::SharingPolicy::SHARED;
+    sg_platf_new_link(&link);
+    simgrid::kernel::resource::LinkImpl* impl = simgrid::s4u::Link::by_name(link.id)->get_impl();
+    link_ids.insert({impl, link_ids.size()});
+
+    simgrid::kernel::routing::RouteCreationArgs route;
+    route.src         = routers[edge.first];
+    route.dst         = routers[edge.second];
+    route.symmetrical = true;
+    route.link_list.push_back(impl);
+    sg_platf_new_route(&route);
+  }
+
+  xbt_os_timer_t timer = xbt_os_timer_new();
+  xbt_os_walltimer_start(timer);
+  sg_platf_new_Zone_seal();
+  xbt_os_walltimer_stop(timer);
+
+  /* Checksum the routes from a few sources toward every router */
+  unsigned long hops     = 0;
+  unsigned long checksum = 0;
+  for (unsigned int src = 0; src < size; src += (size + 7) / 8)
+    for (unsigned int dst = 0; dst < size; dst++) {
+      std::vector<simgrid::kernel::resource::LinkImpl*> links;
+      simgrid::kernel::routing::NetZoneImpl::get_global_route(routers[src], routers[dst], links, nullptr);
+      hops += links.size();
+      for (auto const& link : links) {
+        auto id  = link_ids.find(link); // The loopback link is not one of ours
+        checksum = checksum * 31 + (id == link_ids.end() ? 0 : id->second + 1);
+      }
+    }
+  printf("%s zone of %u routers and %zu links: %lu hops, checksum %016lx\n", args[0], size, link_ids.size(), hops,
+         checksum);
+  if (timings)
+    printf("Sealed in %f seconds\n", xbt_os_timer_elapsed(timer));
+
+  xbt_os_timer_free(timer);
+  return 0;
+}
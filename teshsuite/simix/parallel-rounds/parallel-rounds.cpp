@@ -0,0 +1,68 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Alternates between scheduling rounds with many actors to run, and rounds with a single one, to check how the
+ * rounds are dispatched between the sequential and the parallel execution of the actors. */
+
+#include <simgrid/s4u.hpp>
+#include <simgrid/simix.h>
+#include <simgrid/simix.hpp>
+
+#include <string>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(test, "my log messages");
+
+constexpr int BURST_ACTORS = 100;
+constexpr int BURSTS       = 5;
+constexpr int TICKS        = 50;
+
+static int bursts_done = 0;
+
+static unsigned long some_work(unsigned long seed)
+{
+  for (int i = 0; i < 1000; i++)
+    seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+  return seed;
+}
+
+static void burst(int id)
+{
+  unsigned long value = id;
+  for (int i = 0; i < BURSTS; i++) {
+    simgrid::s4u::this_actor::sleep_for(10);
+    value = some_work(value);
+  }
+  simgrid::s4u::this_actor::sleep_for(value % 2 + 1);
+  simgrid::simix::simcall([] { bursts_done++; });
+}
+
+static void ticker()
+{
+  for (int i = 0; i < TICKS; i++)
+    simgrid::s4u::this_actor::sleep_for(1.5);
+  XBT_INFO("Done ticking");
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc > 2, "Usage: %s platform_file (total|detail)\n", argv[0]);
+  e.load_platform(argv[1]);
+
+  simgrid::s4u::Host* host = e.get_all_hosts().front();
+  for (int i = 0; i < BURST_ACTORS; i++)
+    simgrid::s4u::Actor::create("burst-" + std::to_string(i), host, burst, i);
+  simgrid::s4u::Actor::create("ticker", host, ticker);
+  e.run();
+
+  XBT_INFO("%d bursting actors done", bursts_done);
+  unsigned long sequential = SIMIX_context_get_rounds(false);
+  unsigned long parallel   = SIMIX_context_get_rounds(true);
+  if (std::string(argv[2]) == "detail")
+    XBT_INFO("%lu sequential rounds, %lu parallel rounds", sequential, parallel);
+  else
+    XBT_INFO("%lu rounds", sequential + parallel);
+  return 0;
+}
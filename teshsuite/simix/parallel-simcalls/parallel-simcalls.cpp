@@ -0,0 +1,73 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Many pairs of actors exchanging messages on their own mailbox and locking their own mutex, so that most of their
+ * simcalls touch distinct kernel objects. The output must not depend on whether these simcalls are handled in
+ * parallel (--cfg=simix/parallel-simcalls:yes) or not. */
+
+#include <simgrid/s4u.hpp>
+
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(test, "my log messages");
+
+constexpr int PAIRS    = 32;
+constexpr int MESSAGES = 10;
+
+static std::vector<simgrid::s4u::MutexPtr> mutexes;
+static std::vector<int> shared_counters(PAIRS, 0);
+
+static void sender(int id)
+{
+  simgrid::s4u::Mailbox* mbox = simgrid::s4u::Mailbox::by_name("mailbox-" + std::to_string(id));
+  for (int i = 0; i < MESSAGES; i++) {
+    mutexes[id]->lock();
+    shared_counters[id]++;
+    mutexes[id]->unlock();
+    simgrid::s4u::CommPtr comm = mbox->put_async(new int(id * MESSAGES + i), 1e5 * (id % 4 + 1));
+    simgrid::s4u::this_actor::execute(1e7 * (id % 3 + 1));
+    comm->wait();
+  }
+}
+
+static void receiver(int id)
+{
+  simgrid::s4u::Mailbox* mbox = simgrid::s4u::Mailbox::by_name("mailbox-" + std::to_string(id));
+  int sum                     = 0;
+  for (int i = 0; i < MESSAGES; i++) {
+    int* payload              = nullptr;
+    simgrid::s4u::CommPtr comm = mbox->get_async(reinterpret_cast<void**>(&payload));
+    if (i % 2 == 0 && mutexes[id]->try_lock()) {
+      shared_counters[id]++;
+      mutexes[id]->unlock();
+    }
+    comm->wait();
+    sum += *payload;
+    delete payload;
+  }
+  mutexes[id]->lock();
+  XBT_INFO("Received a total of %d, counter is %d", sum, shared_counters[id]);
+  mutexes[id]->unlock();
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file\n", argv[0]);
+  e.load_platform(argv[1]);
+
+  std::vector<simgrid::s4u::Host*> hosts = e.get_all_hosts();
+  for (int i = 0; i < PAIRS; i++) {
+    mutexes.push_back(simgrid::s4u::Mutex::create());
+    simgrid::s4u::Actor::create("sender-" + std::to_string(i), hosts[i % hosts.size()], sender, i);
+    simgrid::s4u::Actor::create("receiver-" + std::to_string(i), hosts[(i + 1) % hosts.size()], receiver, i);
+  }
+  e.run();
+  mutexes.clear();
+
+  XBT_INFO("Simulation ended");
+  return 0;
+}
@@ -0,0 +1,89 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Many actors waiting for heartbeats with periodic timeouts, so that many of the timers they set are cancelled before
+ * firing. Some actors are also killed by their kill time. The output must not depend on the implementation of the
+ * timers (--cfg=simix/timers:heap or wheel), nor on the duration of the ticks of the wheel. */
+
+#include <simgrid/s4u.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(test, "my log messages");
+
+static int actors_count = 2000;
+static int rounds       = 20;
+
+static int heartbeats  = 0;
+static int timeouts    = 0;
+static int killed      = 0;
+static double checksum = 0;
+
+static int payload = 42;
+static int goodbye = 0;
+
+static void heartbeat(int id)
+{
+  simgrid::s4u::Mailbox* mine = simgrid::s4u::Mailbox::by_name("heartbeat-" + std::to_string(id));
+  simgrid::s4u::Mailbox* peer = simgrid::s4u::Mailbox::by_name("heartbeat-" + std::to_string(id ^ 1));
+  simgrid::s4u::this_actor::on_exit([](bool failed) {
+    if (failed)
+      killed++;
+  });
+
+  void* received;
+  std::vector<simgrid::s4u::CommPtr> pending = {mine->get_async(&received)};
+  unsigned seed = id * 2654435761U + 1;
+  for (int i = 0; i < rounds; i++) {
+    seed = seed * 1103515245U + 12345U;
+    simgrid::s4u::this_actor::sleep_for(1e-4 * (seed % 1000));
+    if (seed % 5 != 0)
+      peer->put_init(&payload, 1000)->detach();
+    // Each wait either sets a timer that fires, or one that gets cancelled when the heartbeat arrives
+    if (simgrid::s4u::Comm::wait_any_for(&pending, 1e-4 * (1 + seed % 3000)) == -1) {
+      timeouts++;
+    } else if (received == &goodbye) { // The peer is gone: only timeouts from now on
+      pending[0] = mine->get_async(&received);
+    } else {
+      heartbeats++;
+      pending[0] = mine->get_async(&received);
+    }
+    checksum += simgrid::s4u::Engine::get_clock();
+  }
+
+  // Say goodbye, and consume the heartbeats of the peer until its own goodbye (if it is not gone already)
+  simgrid::s4u::CommPtr farewell = peer->put_async(&goodbye, 1000);
+  while (received != &goodbye) {
+    pending[0]->wait();
+    if (received != &goodbye)
+      pending[0] = mine->get_async(&received);
+  }
+  farewell->wait();
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file [actors_count [rounds]]\n", argv[0]);
+  e.load_platform(argv[1]);
+  if (argc > 2)
+    actors_count = std::atoi(argv[2]);
+  if (argc > 3)
+    rounds = std::atoi(argv[3]);
+
+  std::vector<simgrid::s4u::Host*> hosts = e.get_all_hosts();
+  for (int i = 0; i < actors_count; i++) {
+    simgrid::s4u::ActorPtr actor =
+        simgrid::s4u::Actor::create("heartbeat-" + std::to_string(i), hosts[i % hosts.size()], heartbeat, i);
+    actor->set_kill_time(i / 2 % 7 == 0 ? 2.0 + i / 2 % 13 : 1000.0); // Both peers die at once
+  }
+  e.run();
+
+  XBT_INFO("%d heartbeats received, %d timeouts, %d actors killed (checksum: %.6f)", heartbeats, timeouts, killed,
+           checksum);
+  return 0;
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Times the collectives, to compare their analytic models (smpi/<collective>:analytic) with their expansion into
+ * point-to-point communications. */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int rank;
+static int size;
+
+static void report(const char* name, int bytes, double start)
+{
+  double duration = MPI_Wtime() - start;
+  double longest;
+  MPI_Reduce(&duration, &longest, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+  if (rank == 0)
+    printf("%-9s %6d bytes: %.6f s\n", name, bytes, longest);
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  int counts[] = {16, 4096};
+  for (int i = 0; i < 2; i++) {
+    int count  = counts[i];
+    int bytes  = count * sizeof(int);
+    int* sbuf  = (int*)malloc(bytes * size);
+    int* rbuf  = (int*)malloc(bytes * size);
+    memset(sbuf, 0, bytes * size);
+    double start;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    MPI_Barrier(MPI_COMM_WORLD);
+    report("barrier", 0, start);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    MPI_Bcast(sbuf, count, MPI_INT, 0, MPI_COMM_WORLD);
+    report("bcast", bytes, start);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    MPI_Reduce(sbuf, rbuf, count, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    report("reduce", bytes, start);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    MPI_Allreduce(sbuf, rbuf, count, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    report("allreduce", bytes, start);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    MPI_Allgather(sbuf, count, MPI_INT, rbuf, count, MPI_INT, MPI_COMM_WORLD);
+    report("allgather", bytes, start);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    MPI_Alltoall(sbuf, count, MPI_INT, rbuf, count, MPI_INT, MPI_COMM_WORLD);
+    report("alltoall", bytes, start);
+
+    free(sbuf);
+    free(rbuf);
+  }
+
+  MPI_Finalize();
+  return 0;
+}
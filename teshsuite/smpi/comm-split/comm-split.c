@@ -0,0 +1,121 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Checks the ranks and the members of the communicators created by MPI_Comm_split, with regular colors (rows and
+ * columns of a grid), irregular colors and keys, and ranks left out. With -t N, also measures the time taken by N
+ * splits of MPI_COMM_WORLD into rows. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "mpi.h"
+
+/* The clocks of the C library give the simulated time in SMPI, but not the resource usage */
+static double host_time(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6;
+}
+
+/* Checks that the new communicator has the expected rank and size, and gathers its members in the order of their
+ * rank to compare them with the expected ones */
+static int check_split(const char* name, int color, int key, int expected_rank, int expected_size, const int* members)
+{
+  int rank;
+  int errors = 0;
+  MPI_Comm comm;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_split(MPI_COMM_WORLD, color, key, &comm);
+  if (color == MPI_UNDEFINED) {
+    if (comm != MPI_COMM_NULL)
+      errors++;
+  } else {
+    int new_rank;
+    int new_size;
+    MPI_Comm_rank(comm, &new_rank);
+    MPI_Comm_size(comm, &new_size);
+    if (new_rank != expected_rank || new_size != expected_size) {
+      errors++;
+    } else {
+      int* ranks = malloc(new_size * sizeof(int));
+      MPI_Allgather(&rank, 1, MPI_INT, ranks, 1, MPI_INT, comm);
+      for (int i = 0; i < new_size; i++)
+        if (ranks[i] != members[i])
+          errors++;
+      free(ranks);
+    }
+    MPI_Comm_free(&comm);
+  }
+  int total;
+  MPI_Reduce(&errors, &total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  if (rank == 0)
+    printf("%s: %d errors\n", name, total);
+  return total;
+}
+
+int main(int argc, char* argv[])
+{
+  int rank;
+  int size;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  int columns = 1;
+  while (columns * columns < size)
+    columns++;
+  int rows     = (size + columns - 1) / columns;
+  int* members = malloc(size * sizeof(int));
+
+  /* Rows of the grid, in the same order */
+  int row = rank / columns;
+  int n   = 0;
+  for (int i = row * columns; i < size && i < (row + 1) * columns; i++)
+    members[n++] = i;
+  check_split("Rows", row, 0, rank % columns, n, members);
+
+  /* Columns of the grid, in the reverse order */
+  int column = rank % columns;
+  n          = 0;
+  for (int i = (rows - 1) * columns + column; i >= 0; i -= columns)
+    if (i < size)
+      members[n++] = i;
+  int new_rank = 0;
+  while (members[new_rank] != rank)
+    new_rank++;
+  check_split("Reversed columns", column, size - rank, new_rank, n, members);
+
+  /* Ranks whose color is their rank modulo 3, with equal keys in each pair of ranks, and ranks 5 modulo 7 left out */
+  int color = rank % 7 == 5 ? MPI_UNDEFINED : rank % 3;
+  n         = 0;
+  for (int key = 0; key <= size / 2; key++)
+    for (int i = 0; i < size; i++)
+      if (i % 7 != 5 && i % 3 == color && (size - i) / 2 == key) {
+        if (i == rank)
+          new_rank = n;
+        members[n++] = i;
+      }
+  check_split("Irregular colors", color, (size - rank) / 2, new_rank, n, members);
+
+  if (argc > 2 && strcmp(argv[1], "-t") == 0) {
+    int rounds = atoi(argv[2]);
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = host_time();
+    for (int i = 0; i < rounds; i++) {
+      MPI_Comm comm;
+      MPI_Comm_split(MPI_COMM_WORLD, row, rank, &comm);
+      MPI_Comm_free(&comm);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == 0)
+      printf("Split of %d ranks into %d rows: %.3f ms\n", size, rows, (host_time() - start) * 1e3 / rounds);
+  }
+
+  free(members);
+  MPI_Finalize();
+  return 0;
+}
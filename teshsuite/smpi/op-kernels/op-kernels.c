@@ -0,0 +1,269 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Checks the predefined reduction operations on all the predefined datatypes they apply to, and the reductions into
+ * strided datatypes. With -t, also measures the time taken by each operation on large vectors. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "mpi.h"
+
+#define SIZE 1000
+#define BENCH_SIZE (1 << 20)
+#define BENCH_ROUNDS 20
+
+#define MAX_EXPR(a, b) ((a) < (b) ? (b) : (a))
+#define MIN_EXPR(a, b) ((a) < (b) ? (a) : (b))
+#define SUM_EXPR(a, b) ((b) + (a))
+#define PROD_EXPR(a, b) ((b) * (a))
+#define LAND_EXPR(a, b) ((a) && (b))
+#define LOR_EXPR(a, b) ((a) || (b))
+#define LXOR_EXPR(a, b) ((!(a) && (b)) || ((a) && !(b)))
+#define BAND_EXPR(a, b) ((b) & (a))
+#define BOR_EXPR(a, b) ((b) | (a))
+#define BXOR_EXPR(a, b) ((b) ^ (a))
+#define MAXLOC_EXPR(a, b)                                                                                              \
+  ((a).value < (b).value ? (b) : ((a).value == (b).value ? ((a).index < (b).index ? (a) : (b)) : (a)))
+#define MINLOC_EXPR(a, b)                                                                                              \
+  ((a).value < (b).value ? (a) : ((a).value == (b).value ? ((a).index < (b).index ? (a) : (b)) : (b)))
+
+static int bench = 0;
+static int checked;
+static int failed;
+
+/* The clocks of the C library give the simulated time in SMPI, but not the resource usage */
+static double host_time(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6;
+}
+
+#define SET_VALUE(x, v) (x) = (v)
+#define SET_PAIR(x, v) ((x).value = (v) / 2, (x).index = (v) % 3)
+#define EQUAL_VALUE(x, y) ((x) == (y))
+#define EQUAL_PAIR(x, y) ((x).value == (y).value && (x).index == (y).index)
+
+/* Reduces an array with MPI_Reduce_local, and compares the result with the one of the C expression */
+#define CHECK_TYPE(opname, op, expr, type, dtype, set, equal)                                                          \
+  {                                                                                                                    \
+    type* in       = malloc(SIZE * sizeof(type));                                                                      \
+    type* inout    = malloc(SIZE * sizeof(type));                                                                      \
+    type* expected = malloc(SIZE * sizeof(type));                                                                      \
+    for (int i = 0; i < SIZE; i++) {                                                                                   \
+      set(in[i], i % 7 + (i & 1));                                                                                     \
+      set(inout[i], (i * 3) % 11 + (i & 2));                                                                           \
+      expected[i] = expr(in[i], inout[i]);                                                                             \
+    }                                                                                                                  \
+    MPI_Reduce_local(in, inout, SIZE, dtype, op);                                                                      \
+    for (int i = 0; i < SIZE; i++)                                                                                     \
+      if (!equal(inout[i], expected[i])) {                                                                             \
+        printf("%s on %s: wrong value at index %d\n", opname, #dtype, i);                                              \
+        failed++;                                                                                                      \
+        break;                                                                                                         \
+      }                                                                                                                \
+    checked++;                                                                                                         \
+    free(in);                                                                                                          \
+    free(inout);                                                                                                       \
+    free(expected);                                                                                                    \
+    if (bench) {                                                                                                       \
+      type* bin    = calloc(BENCH_SIZE, sizeof(type));                                                                 \
+      type* binout = calloc(BENCH_SIZE, sizeof(type));                                                                 \
+      double start = host_time();                                                                                      \
+      for (int r = 0; r < BENCH_ROUNDS; r++)                                                                           \
+        MPI_Reduce_local(bin, binout, BENCH_SIZE, dtype, op);                                                          \
+      printf("%-10s %-26s %7.3f ns/element\n", opname, #dtype,                                                         \
+             (host_time() - start) * 1e9 / BENCH_ROUNDS / BENCH_SIZE);                                                 \
+      free(bin);                                                                                                       \
+      free(binout);                                                                                                    \
+    }                                                                                                                  \
+  }
+
+#define CHECK(opname, op, expr, type, dtype) CHECK_TYPE(opname, op, expr, type, dtype, SET_VALUE, EQUAL_VALUE)
+
+#define CHECK_INTEGERS(opname, op, expr)                                                                               \
+  CHECK(opname, op, expr, char, MPI_CHAR)                                                                              \
+  CHECK(opname, op, expr, short, MPI_SHORT)                                                                            \
+  CHECK(opname, op, expr, int, MPI_INT)                                                                                \
+  CHECK(opname, op, expr, long, MPI_LONG)                                                                              \
+  CHECK(opname, op, expr, long long, MPI_LONG_LONG)                                                                    \
+  CHECK(opname, op, expr, signed char, MPI_SIGNED_CHAR)                                                                \
+  CHECK(opname, op, expr, unsigned char, MPI_UNSIGNED_CHAR)                                                            \
+  CHECK(opname, op, expr, unsigned short, MPI_UNSIGNED_SHORT)                                                          \
+  CHECK(opname, op, expr, unsigned int, MPI_UNSIGNED)                                                                  \
+  CHECK(opname, op, expr, unsigned long, MPI_UNSIGNED_LONG)                                                            \
+  CHECK(opname, op, expr, unsigned long long, MPI_UNSIGNED_LONG_LONG)                                                  \
+  CHECK(opname, op, expr, wchar_t, MPI_WCHAR)                                                                          \
+  CHECK(opname, op, expr, int8_t, MPI_BYTE)                                                                            \
+  CHECK(opname, op, expr, int8_t, MPI_INT8_T)                                                                          \
+  CHECK(opname, op, expr, int16_t, MPI_INT16_T)                                                                        \
+  CHECK(opname, op, expr, int32_t, MPI_INT32_T)                                                                        \
+  CHECK(opname, op, expr, int64_t, MPI_INT64_T)                                                                        \
+  CHECK(opname, op, expr, uint8_t, MPI_UINT8_T)                                                                        \
+  CHECK(opname, op, expr, uint16_t, MPI_UINT16_T)                                                                      \
+  CHECK(opname, op, expr, uint32_t, MPI_UINT32_T)                                                                      \
+  CHECK(opname, op, expr, uint64_t, MPI_UINT64_T)                                                                      \
+  CHECK(opname, op, expr, MPI_Aint, MPI_AINT)                                                                          \
+  CHECK(opname, op, expr, MPI_Offset, MPI_OFFSET)                                                                      \
+  CHECK(opname, op, expr, int, MPI_INTEGER1)                                                                           \
+  CHECK(opname, op, expr, int16_t, MPI_INTEGER2)                                                                       \
+  CHECK(opname, op, expr, int32_t, MPI_INTEGER4)                                                                       \
+  CHECK(opname, op, expr, int64_t, MPI_INTEGER8)                                                                       \
+  CHECK(opname, op, expr, long long, MPI_COUNT)
+
+#define CHECK_FLOATS(opname, op, expr)                                                                                 \
+  CHECK(opname, op, expr, float, MPI_FLOAT)                                                                            \
+  CHECK(opname, op, expr, double, MPI_DOUBLE)                                                                          \
+  CHECK(opname, op, expr, long double, MPI_LONG_DOUBLE)                                                                \
+  CHECK(opname, op, expr, float, MPI_REAL)                                                                             \
+  CHECK(opname, op, expr, float, MPI_REAL4)                                                                            \
+  CHECK(opname, op, expr, double, MPI_REAL8)                                                                           \
+  CHECK(opname, op, expr, long double, MPI_REAL16)
+
+#define CHECK_COMPLEXES(opname, op, expr)                                                                              \
+  CHECK(opname, op, expr, float _Complex, MPI_C_FLOAT_COMPLEX)                                                         \
+  CHECK(opname, op, expr, double _Complex, MPI_C_DOUBLE_COMPLEX)                                                       \
+  CHECK(opname, op, expr, long double _Complex, MPI_C_LONG_DOUBLE_COMPLEX)
+
+#define CHECK_PAIR(opname, op, expr, type, dtype) CHECK_TYPE(opname, op, expr, type, dtype, SET_PAIR, EQUAL_PAIR)
+
+#define CHECK_PAIRS(opname, op, expr)                                                                                  \
+  CHECK_PAIR(opname, op, expr, struct float_int, MPI_FLOAT_INT)                                                        \
+  CHECK_PAIR(opname, op, expr, struct long_int, MPI_LONG_INT)                                                          \
+  CHECK_PAIR(opname, op, expr, struct double_int, MPI_DOUBLE_INT)                                                      \
+  CHECK_PAIR(opname, op, expr, struct short_int, MPI_SHORT_INT)                                                        \
+  CHECK_PAIR(opname, op, expr, struct int_int, MPI_2INT)                                                               \
+  CHECK_PAIR(opname, op, expr, struct float_float, MPI_2FLOAT)                                                         \
+  CHECK_PAIR(opname, op, expr, struct double_double, MPI_2DOUBLE)                                                      \
+  CHECK_PAIR(opname, op, expr, struct long_double_int, MPI_LONG_DOUBLE_INT)                                            \
+  CHECK_PAIR(opname, op, expr, struct long_long, MPI_2LONG)
+
+struct float_int {
+  float value;
+  int index;
+};
+struct long_int {
+  long value;
+  int index;
+};
+struct double_int {
+  double value;
+  int index;
+};
+struct short_int {
+  short value;
+  int index;
+};
+struct int_int {
+  int value;
+  int index;
+};
+struct float_float {
+  float value;
+  float index;
+};
+struct double_double {
+  double value;
+  double index;
+};
+struct long_double_int {
+  long double value;
+  int index;
+};
+struct long_long {
+  long value;
+  long index;
+};
+
+#define REPORT(opname, block)                                                                                          \
+  {                                                                                                                    \
+    checked = 0;                                                                                                       \
+    block;                                                                                                             \
+    if (!bench)                                                                                                        \
+      printf("%-10s %2d datatypes checked\n", opname, checked);                                                        \
+  }
+
+static void check_predefined_operations(void)
+{
+  REPORT("MPI_MAX", CHECK_INTEGERS("MPI_MAX", MPI_MAX, MAX_EXPR) CHECK_FLOATS("MPI_MAX", MPI_MAX, MAX_EXPR))
+  REPORT("MPI_MIN", CHECK_INTEGERS("MPI_MIN", MPI_MIN, MIN_EXPR) CHECK_FLOATS("MPI_MIN", MPI_MIN, MIN_EXPR))
+  REPORT("MPI_SUM", CHECK_INTEGERS("MPI_SUM", MPI_SUM, SUM_EXPR) CHECK_FLOATS("MPI_SUM", MPI_SUM, SUM_EXPR)
+                        CHECK_COMPLEXES("MPI_SUM", MPI_SUM, SUM_EXPR))
+  REPORT("MPI_PROD", CHECK_INTEGERS("MPI_PROD", MPI_PROD, PROD_EXPR) CHECK_FLOATS("MPI_PROD", MPI_PROD, PROD_EXPR)
+                         CHECK_COMPLEXES("MPI_PROD", MPI_PROD, PROD_EXPR))
+  REPORT("MPI_LAND", CHECK_INTEGERS("MPI_LAND", MPI_LAND, LAND_EXPR) CHECK(
+                         "MPI_LAND", MPI_LAND, LAND_EXPR, _Bool, MPI_C_BOOL))
+  REPORT("MPI_LOR", CHECK_INTEGERS("MPI_LOR", MPI_LOR, LOR_EXPR) CHECK("MPI_LOR", MPI_LOR, LOR_EXPR, _Bool, MPI_C_BOOL))
+  REPORT("MPI_LXOR", CHECK_INTEGERS("MPI_LXOR", MPI_LXOR, LXOR_EXPR) CHECK(
+                         "MPI_LXOR", MPI_LXOR, LXOR_EXPR, _Bool, MPI_C_BOOL))
+  REPORT("MPI_BAND", CHECK_INTEGERS("MPI_BAND", MPI_BAND, BAND_EXPR) CHECK(
+                         "MPI_BAND", MPI_BAND, BAND_EXPR, _Bool, MPI_C_BOOL))
+  REPORT("MPI_BOR", CHECK_INTEGERS("MPI_BOR", MPI_BOR, BOR_EXPR) CHECK("MPI_BOR", MPI_BOR, BOR_EXPR, _Bool, MPI_C_BOOL))
+  REPORT("MPI_BXOR", CHECK_INTEGERS("MPI_BXOR", MPI_BXOR, BXOR_EXPR) CHECK(
+                         "MPI_BXOR", MPI_BXOR, BXOR_EXPR, _Bool, MPI_C_BOOL))
+  REPORT("MPI_MAXLOC", CHECK_PAIRS("MPI_MAXLOC", MPI_MAXLOC, MAXLOC_EXPR))
+  REPORT("MPI_MINLOC", CHECK_PAIRS("MPI_MINLOC", MPI_MINLOC, MINLOC_EXPR))
+}
+
+/* Rank 0 sends blocks of 3 doubles to rank 1, that receives them (or accumulates them) every 5 doubles */
+#define BLOCKS 100
+static void check_strided_reductions(int rank)
+{
+  double contiguous[3 * BLOCKS];
+  double strided[5 * BLOCKS];
+  MPI_Datatype vector;
+  MPI_Type_vector(BLOCKS, 3, 5, MPI_DOUBLE, &vector);
+  MPI_Type_commit(&vector);
+  for (int i = 0; i < 3 * BLOCKS; i++)
+    contiguous[i] = i;
+  for (int i = 0; i < 5 * BLOCKS; i++)
+    strided[i] = -1;
+
+  if (rank == 0)
+    MPI_Send(contiguous, 3 * BLOCKS, MPI_DOUBLE, 1, 0, MPI_COMM_WORLD);
+  else if (rank == 1)
+    MPI_Recv(strided, 1, vector, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+  MPI_Win win;
+  MPI_Win_create(strided, sizeof(strided), sizeof(double), MPI_INFO_NULL, MPI_COMM_WORLD, &win);
+  MPI_Win_fence(0, win);
+  if (rank == 0)
+    MPI_Accumulate(contiguous, 3 * BLOCKS, MPI_DOUBLE, 1, 0, 1, vector, MPI_SUM, win);
+  MPI_Win_fence(0, win);
+  MPI_Win_free(&win);
+
+  if (rank == 1) {
+    int errors = 0;
+    for (int i = 0; i < 5 * BLOCKS; i++) {
+      double expected = (i % 5 < 3) ? 2.0 * (i / 5 * 3 + i % 5) : -1;
+      if (strided[i] != expected)
+        errors++;
+    }
+    printf("Strided reception and accumulation: %d errors\n", errors);
+  }
+  MPI_Type_free(&vector);
+}
+
+int main(int argc, char* argv[])
+{
+  int rank;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (argc > 1 && strcmp(argv[1], "-t") == 0)
+    bench = 1;
+
+  if (rank == 0) {
+    check_predefined_operations();
+    printf("%d errors\n", failed);
+  }
+  check_strided_reductions(rank);
+
+  MPI_Finalize();
+  return 0;
+}
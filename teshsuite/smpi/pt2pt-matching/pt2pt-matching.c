@@ -0,0 +1,119 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Many pending messages matched out of order, with some wildcards: the matching must respect the MPI ordering rules
+ * whether the mailboxes are indexed or not (smpi/indexed-matching) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(matching, "the matching test");
+
+#define N 500
+
+static int errors = 0;
+
+static void check(const char* phase, int got, int expected)
+{
+  if (got != expected) {
+    printf("%s: Damn, data does not match (got %d instead of %d)\n", phase, got, expected);
+    errors++;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  int rank;
+  int size;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  if (size != 3) {
+    printf("This test needs 3 processes\n");
+    MPI_Finalize();
+    return 0;
+  }
+
+  /* Receives posted first, messages sent in reverse order of tags */
+  if (rank == 0) {
+    int* data            = (int*)malloc(sizeof(int) * (2 * N + 3));
+    MPI_Request* request = (MPI_Request*)malloc(sizeof(MPI_Request) * (2 * N + 3));
+    MPI_Status status;
+    for (int tag = 0; tag < N; tag++) {
+      MPI_Irecv(&data[2 * tag], 1, MPI_INT, 1, tag, MPI_COMM_WORLD, &request[2 * tag]);
+      MPI_Irecv(&data[2 * tag + 1], 1, MPI_INT, 2, tag, MPI_COMM_WORLD, &request[2 * tag + 1]);
+    }
+    MPI_Irecv(&data[2 * N], 1, MPI_INT, MPI_ANY_SOURCE, N, MPI_COMM_WORLD, &request[2 * N]);
+    MPI_Irecv(&data[2 * N + 1], 1, MPI_INT, MPI_ANY_SOURCE, N, MPI_COMM_WORLD, &request[2 * N + 1]);
+    MPI_Irecv(&data[2 * N + 2], 1, MPI_INT, 1, MPI_ANY_TAG, MPI_COMM_WORLD, &request[2 * N + 2]);
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (int i = 0; i < 2 * N; i++) {
+      MPI_Wait(&request[i], MPI_STATUS_IGNORE);
+      check("posted receives", data[i], (1 + i % 2) * 100000 + i / 2);
+    }
+    MPI_Wait(&request[2 * N], MPI_STATUS_IGNORE);
+    MPI_Wait(&request[2 * N + 1], MPI_STATUS_IGNORE);
+    check("any source", data[2 * N] + data[2 * N + 1], 100000 + N + 200000 + N);
+    MPI_Wait(&request[2 * N + 2], &status);
+    check("any tag", status.MPI_TAG, N + 1);
+    check("any tag", data[2 * N + 2], 100000 + N + 1);
+    free(data);
+    free(request);
+  } else {
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (int tag = N - 1; tag >= 0; tag--) {
+      int value = rank * 100000 + tag;
+      MPI_Send(&value, 1, MPI_INT, 0, tag, MPI_COMM_WORLD);
+    }
+    int value = rank * 100000 + N;
+    MPI_Send(&value, 1, MPI_INT, 0, N, MPI_COMM_WORLD);
+    if (rank == 1) {
+      value = rank * 100000 + N + 1;
+      MPI_Send(&value, 1, MPI_INT, 0, N + 1, MPI_COMM_WORLD);
+    }
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD); // Don't let the wildcards of the first phase match the messages of the second one
+
+  /* Messages sent first (synchronously, so that they wait in the mailbox), received in reverse order of tags */
+  if (rank == 0) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (int tag = N - 1; tag >= 0; tag--)
+      for (int src = 2; src >= 1; src--) {
+        int value;
+        MPI_Recv(&value, 1, MPI_INT, src, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        check("pending sends", value, src * 100000 + tag);
+      }
+    for (int i = 0; i < 2; i++) { // Messages of the same source and tag are not overtaking
+      int value;
+      MPI_Recv(&value, 1, MPI_INT, 1, N, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      check("non-overtaking", value, i);
+    }
+  } else {
+    MPI_Request* request = (MPI_Request*)malloc(sizeof(MPI_Request) * (N + 2));
+    int* data            = (int*)malloc(sizeof(int) * (N + 2));
+    for (int tag = 0; tag < N; tag++) {
+      data[tag] = rank * 100000 + tag;
+      MPI_Issend(&data[tag], 1, MPI_INT, 0, tag, MPI_COMM_WORLD, &request[tag]);
+    }
+    int count = N;
+    if (rank == 1) {
+      for (int i = 0; i < 2; i++) {
+        data[N + i] = i;
+        MPI_Issend(&data[N + i], 1, MPI_INT, 0, N, MPI_COMM_WORLD, &request[N + i]);
+      }
+      count = N + 2;
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Waitall(count, request, MPI_STATUSES_IGNORE);
+    free(request);
+    free(data);
+  }
+
+  if (rank == 0)
+    XBT_INFO("%d messages matched, %d errors", (2 * N + 3) + (2 * N + 2), errors);
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,147 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Exchanges the halo of a 3D grid of structures, described by nested vectors of a structure datatype, and checks the
+ * data received and packed. With -t, also measures the time taken to pack and unpack this halo. */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "mpi.h"
+
+#define PLANES 8
+#define ROWS 32
+#define COLUMNS 32
+#define HALO 2
+#define BENCH_ROUNDS 2000
+
+struct cell {
+  double value;
+  int tag;
+  double flux;
+};
+
+/* The clocks of the C library give the simulated time in SMPI, but not the resource usage */
+static double host_time(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6;
+}
+
+/* The value and flux of the HALO last cells of each row of each plane */
+static MPI_Datatype create_halo_type(void)
+{
+  int lengths[2]        = {1, 1};
+  MPI_Aint displs[2]    = {offsetof(struct cell, value), offsetof(struct cell, flux)};
+  MPI_Datatype types[2] = {MPI_DOUBLE, MPI_DOUBLE};
+  MPI_Datatype fields;
+  MPI_Datatype cell;
+  MPI_Datatype plane;
+  MPI_Datatype halo;
+  MPI_Type_create_struct(2, lengths, displs, types, &fields);
+  MPI_Type_create_resized(fields, 0, sizeof(struct cell), &cell);
+  MPI_Type_vector(ROWS, HALO, COLUMNS, cell, &plane);
+  MPI_Type_create_hvector(PLANES, 1, ROWS * COLUMNS * sizeof(struct cell), plane, &halo);
+  MPI_Type_commit(&halo);
+  MPI_Type_free(&fields);
+  MPI_Type_free(&cell);
+  MPI_Type_free(&plane);
+  return halo;
+}
+
+static double value_of(int plane, int row, int column)
+{
+  return (plane * ROWS + row) * COLUMNS + column;
+}
+
+/* The halo starts at the column COLUMNS - HALO, and its values are sent in order, each one followed by its flux */
+static int check_halo(const double* buf)
+{
+  int errors = 0;
+  for (int p = 0; p < PLANES; p++)
+    for (int r = 0; r < ROWS; r++)
+      for (int c = 0; c < HALO; c++) {
+        double value = value_of(p, r, COLUMNS - HALO + c);
+        if (buf[0] != value || buf[1] != -value)
+          errors++;
+        buf += 2;
+      }
+  return errors;
+}
+
+int main(int argc, char* argv[])
+{
+  int rank;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  int bench = (argc > 1 && strcmp(argv[1], "-t") == 0);
+
+  MPI_Datatype halo = create_halo_type();
+  int size;
+  MPI_Type_size(halo, &size);
+  struct cell* grid = malloc(PLANES * ROWS * COLUMNS * sizeof(struct cell));
+  double* packed    = malloc(size);
+  for (int p = 0; p < PLANES; p++)
+    for (int r = 0; r < ROWS; r++)
+      for (int c = 0; c < COLUMNS; c++) {
+        struct cell* cell = &grid[(p * ROWS + r) * COLUMNS + c];
+        cell->value       = rank == 0 ? value_of(p, r, c) : 0;
+        cell->tag         = c;
+        cell->flux        = rank == 0 ? -value_of(p, r, c) : 0;
+      }
+  struct cell* first = &grid[COLUMNS - HALO];
+
+  /* Rank 0 sends its halo, that rank 1 receives contiguously, then sends back into its own grid */
+  if (rank == 0) {
+    MPI_Send(first, 1, halo, 1, 0, MPI_COMM_WORLD);
+  } else if (rank == 1) {
+    MPI_Recv(packed, size, MPI_BYTE, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    printf("Halo received contiguously: %d errors\n", check_halo(packed));
+    MPI_Sendrecv(packed, size, MPI_BYTE, 1, 1, first, 1, halo, 1, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    int errors = 0;
+    for (int p = 0; p < PLANES; p++)
+      for (int r = 0; r < ROWS; r++)
+        for (int c = 0; c < COLUMNS; c++) {
+          const struct cell* cell = &grid[(p * ROWS + r) * COLUMNS + c];
+          double expected         = c < COLUMNS - HALO ? 0 : value_of(p, r, c);
+          if (cell->value != expected || cell->flux != -expected || cell->tag != c)
+            errors++;
+        }
+    printf("Halo received into the grid: %d errors\n", errors);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (rank == 0) {
+    int position = 0;
+    MPI_Pack(first, 1, halo, packed, size, &position, MPI_COMM_WORLD);
+    printf("Halo packed: %d errors\n", check_halo(packed));
+    if (bench) {
+      double start = host_time();
+      for (int i = 0; i < BENCH_ROUNDS; i++) {
+        position = 0;
+        MPI_Pack(first, 1, halo, packed, size, &position, MPI_COMM_WORLD);
+      }
+      double pack_time = host_time() - start;
+      start            = host_time();
+      for (int i = 0; i < BENCH_ROUNDS; i++) {
+        position = 0;
+        MPI_Unpack(packed, size, &position, first, 1, halo, MPI_COMM_WORLD);
+      }
+      double unpack_time = host_time() - start;
+      printf("Pack of %d bytes: %.3f us, unpack: %.3f us\n", size, pack_time * 1e6 / BENCH_ROUNDS,
+             unpack_time * 1e6 / BENCH_ROUNDS);
+    }
+  }
+
+  free(grid);
+  free(packed);
+  MPI_Type_free(&halo);
+  MPI_Finalize();
+  return 0;
+}
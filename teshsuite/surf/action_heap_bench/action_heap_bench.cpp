@@ -0,0 +1,107 @@
+/* Benchmark of the heaps of actions used by the lazy update of the models  */
+
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "simgrid/kernel/resource/Action.hpp"
+#include "simgrid/kernel/resource/Model.hpp"
+#include "simgrid/s4u/Engine.hpp"
+#include "src/kernel/lmm/maxmin.hpp"
+#include "xbt/xbt_os_time.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using simgrid::kernel::resource::Action;
+using simgrid::kernel::resource::ActionHeap;
+using simgrid::kernel::resource::Model;
+
+namespace {
+class BenchAction : public Action {
+public:
+  BenchAction(Model* model, int id) : Action(model, 1.0, false), id_(id) {}
+  void update_remains_lazy(double) override {}
+  int id_;
+};
+
+/* Replays the kind of trace produced by the lazy update of a model: the earliest action completes and is replaced by
+ * a new one, and a few other actions see their completion date moved because they share a resource with it. The dates
+ * are rounded so that many actions end at the same date. Returns the ids of the popped actions. */
+std::vector<int> replay(Model* model, ActionHeap::Kind kind, int nb_actions, int nb_steps, double* duration)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> ticks(1, 100);
+  std::uniform_int_distribution<int> pick(0, nb_actions - 1);
+  std::vector<int> popped;
+  popped.reserve(nb_steps);
+
+  ActionHeap heap(kind);
+  std::vector<BenchAction*> actions;
+  for (int i = 0; i < nb_actions; i++)
+    actions.push_back(new BenchAction(model, i));
+
+  xbt_os_timer_t timer = xbt_os_timer_new();
+  xbt_os_cputimer_start(timer);
+  double now = 0.0;
+  for (BenchAction* action : actions)
+    heap.insert(action, now + ticks(gen) / 100.0, ActionHeap::Type::normal);
+
+  for (int step = 0; step < nb_steps; step++) {
+    now                 = heap.top_date();
+    BenchAction* action = static_cast<BenchAction*>(heap.pop());
+    popped.push_back(action->id_);
+    for (int i = 0; i < 3; i++) {
+      BenchAction* other = actions[pick(gen)];
+      if (other == action)
+        continue;
+      if (i == 2 && other->get_type() != ActionHeap::Type::unset)
+        heap.remove(other);
+      else
+        heap.update(other, now + ticks(gen) / 100.0, ActionHeap::Type::normal);
+    }
+    heap.insert(action, now + ticks(gen) / 100.0, ActionHeap::Type::normal);
+  }
+  xbt_os_cputimer_stop(timer);
+  *duration = xbt_os_timer_elapsed(timer);
+  xbt_os_timer_free(timer);
+
+  for (BenchAction* action : actions) {
+    if (action->get_type() != ActionHeap::Type::unset)
+      heap.remove(action);
+    delete action;
+  }
+  return popped;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  simgrid::s4u::Engine e(&argc, argv);
+
+  if (argc < 3) {
+    fprintf(stderr, "Syntax: %s <nb_actions> <nb_steps> [perf]\n", argv[0]);
+    return 1;
+  }
+  int nb_actions = atoi(argv[1]);
+  int nb_steps   = atoi(argv[2]);
+  bool perf      = argc >= 4 && strcmp(argv[3], "perf") == 0;
+
+  Model model(Model::UpdateAlgo::LAZY);
+  double pairing_time;
+  double four_ary_time;
+  std::vector<int> pairing  = replay(&model, ActionHeap::Kind::pairing, nb_actions, nb_steps, &pairing_time);
+  std::vector<int> four_ary = replay(&model, ActionHeap::Kind::four_ary, nb_actions, nb_steps, &four_ary_time);
+
+  printf("%d actions, %d steps\n", nb_actions, nb_steps);
+  printf("Both heaps pop the actions in the same order: %s\n", pairing == four_ary ? "yes" : "no");
+  if (perf) {
+    printf("pairing heap: %g s\n", pairing_time);
+    printf("4-ary heap:   %g s\n", four_ary_time);
+  }
+  return 0;
+}
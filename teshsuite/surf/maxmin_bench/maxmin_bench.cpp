@@ -6,6 +6,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/kernel/lmm/maxmin.hpp"
+#include "src/surf/surf_interface.hpp"
 #include "simgrid/msg.h"
 #include "xbt/module.h"
 #include "xbt/sysdep.h" /* time manipulation for benchmarking */
@@ -34,15 +35,20 @@ static unsigned int int_random(int max)
   return static_cast<uint32_t>(float_random(max));
 }
 
-static void test(int nb_cnst, int nb_var, int nb_elem, unsigned int pw_base_limit, unsigned int pw_max_limit,
-                 float rate_no_limit, int max_share, int mode)
+static simgrid::kernel::lmm::System* build_system(bool use_array, int nb_cnst, int nb_var, int nb_elem,
+                                                  unsigned int pw_base_limit, unsigned int pw_max_limit,
+                                                  float rate_no_limit, int max_share,
+                                                  simgrid::kernel::lmm::Constraint** cnst,
+                                                  simgrid::kernel::lmm::Variable** var)
 {
-  simgrid::kernel::lmm::Constraint* cnst[nb_cnst];
-  simgrid::kernel::lmm::Variable* var[nb_var];
   int used[nb_cnst];
 
   /* We cannot activate the selective update as we pass nullptr as an Action when creating the variables */
-  simgrid::kernel::lmm::System* Sys = new simgrid::kernel::lmm::System(false);
+  simgrid::kernel::lmm::System* Sys;
+  if (use_array)
+    Sys = new simgrid::kernel::lmm::ArrayMaxMin(false);
+  else
+    Sys = new simgrid::kernel::lmm::System(false);
 
   for (int i = 0; i < nb_cnst; i++) {
     cnst[i] = Sys->constraint_new(NULL, float_random(10.0));
@@ -76,12 +82,125 @@ static void test(int nb_cnst, int nb_var, int nb_elem, unsigned int pw_base_limi
       used[k]++;
     }
   }
+  return Sys;
+}
+
+/* Counts the differences between the solutions of two systems built the same way */
+static int compare(int nb_cnst, int nb_var, simgrid::kernel::lmm::Constraint** cnst,
+                   simgrid::kernel::lmm::Variable** var, simgrid::kernel::lmm::Constraint** cnst2,
+                   simgrid::kernel::lmm::Variable** var2, double precision)
+{
+  int differences = 0;
+  for (int i = 0; i < nb_var; i++)
+    if (fabs(var[i]->get_value() - var2[i]->get_value()) > precision) {
+      fprintf(stderr, "Variable %i differs: %.17g (default) vs. %.17g (array)\n", i, var[i]->get_value(),
+              var2[i]->get_value());
+      differences++;
+    }
+  for (int i = 0; i < nb_cnst; i++)
+    if (fabs(cnst[i]->get_usage() - cnst2[i]->get_usage()) > precision) {
+      fprintf(stderr, "Constraint %i differs: %.17g (default) vs. %.17g (array)\n", i, cnst[i]->get_usage(),
+              cnst2[i]->get_usage());
+      differences++;
+    }
+  return differences;
+}
+
+/* Applies the same random change to both systems: new bound or weight for a variable, new bound for a constraint, or
+ * replacement of a variable by a new one */
+static void change(simgrid::kernel::lmm::System* Sys, simgrid::kernel::lmm::System* Sys2, int nb_cnst, int nb_var,
+                   int nb_elem, simgrid::kernel::lmm::Constraint** cnst, simgrid::kernel::lmm::Variable** var,
+                   simgrid::kernel::lmm::Constraint** cnst2, simgrid::kernel::lmm::Variable** var2)
+{
+  int i = int_random(nb_var);
+  switch (int_random(4)) {
+    case 0: {
+      double bound = myrand() % 2 ? float_random(2.0) : -1.0;
+      Sys->update_variable_bound(var[i], bound);
+      Sys2->update_variable_bound(var2[i], bound);
+      break;
+    }
+    case 1: {
+      double weight = 1.0 + int_random(3);
+      Sys->update_variable_weight(var[i], weight);
+      Sys2->update_variable_weight(var2[i], weight);
+      break;
+    }
+    case 2: {
+      int k        = int_random(nb_cnst);
+      double bound = float_random(10.0);
+      Sys->update_constraint_bound(cnst[k], bound);
+      Sys2->update_constraint_bound(cnst2[k], bound);
+      break;
+    }
+    default:
+      Sys->variable_free(var[i]);
+      Sys2->variable_free(var2[i]);
+      var[i]  = Sys->variable_new(NULL, 1.0, -1.0, nb_elem);
+      var2[i] = Sys2->variable_new(NULL, 1.0, -1.0, nb_elem);
+      for (int j = 0; j < nb_elem; j++) {
+        int k         = int_random(nb_cnst);
+        double weight = float_random(1.5);
+        Sys->expand_add(cnst[k], var[i], weight);
+        Sys2->expand_add(cnst2[k], var2[i], weight);
+      }
+  }
+}
+
+static void test(int nb_cnst, int nb_var, int nb_elem, unsigned int pw_base_limit, unsigned int pw_max_limit,
+                 float rate_no_limit, int max_share, int mode)
+{
+  simgrid::kernel::lmm::Constraint* cnst[nb_cnst];
+  simgrid::kernel::lmm::Variable* var[nb_var];
+
+  int64_t seed_before                = seedx;
+  simgrid::kernel::lmm::System* Sys = build_system(mode == 5, nb_cnst, nb_var, nb_elem, pw_base_limit, pw_max_limit,
+                                                   rate_no_limit, max_share, cnst, var);
+
+  /* In compare and incremental modes, build the very same system a second time for the array solver */
+  simgrid::kernel::lmm::Constraint* cnst2[nb_cnst];
+  simgrid::kernel::lmm::Variable* var2[nb_var];
+  simgrid::kernel::lmm::System* Sys2 = nullptr;
+  if (mode == 4 || mode == 6) {
+    int64_t seed_after = seedx;
+    seedx              = seed_before;
+    Sys2 = build_system(true, nb_cnst, nb_var, nb_elem, pw_base_limit, pw_max_limit, rate_no_limit, max_share, cnst2,
+                        var2);
+    xbt_assert(seedx == seed_after);
+  }
 
   fprintf(stderr,"Starting to solve(%i)\n",myrand()%1000);
   date = xbt_os_time() * 1000000;
   Sys->solve();
   date = xbt_os_time() * 1000000 - date;
 
+  if (mode == 4) {
+    Sys2->solve();
+    int differences = compare(nb_cnst, nb_var, cnst, var, cnst2, var2, 0.0);
+    fprintf(stderr, "Both solvers agree on %i variables and %i constraints: %s\n", nb_var, nb_cnst,
+            differences ? "no" : "yes");
+  }
+
+  /* In incremental mode, change the systems a little bit between each solve */
+  if (mode == 6) {
+    Sys2->solve();
+    int differences = compare(nb_cnst, nb_var, cnst, var, cnst2, var2, sg_maxmin_precision);
+    int changes     = 50;
+    for (int step = 0; step < changes; step++) {
+      change(Sys, Sys2, nb_cnst, nb_var, nb_elem, cnst, var, cnst2, var2);
+      Sys->solve();
+      Sys2->solve();
+      differences += compare(nb_cnst, nb_var, cnst, var, cnst2, var2, sg_maxmin_precision);
+    }
+    fprintf(stderr, "Both solvers agree after %i changes: %s\n", changes, differences ? "no" : "yes");
+  }
+
+  if (Sys2 != nullptr) {
+    for (int i = 0; i < nb_var; i++)
+      Sys2->variable_free(var2[i]);
+    delete Sys2;
+  }
+
   if(mode==2){
     fprintf(stderr,"Max concurrency:\n");
     int l=0;
@@ -107,12 +226,13 @@ static void test(int nb_cnst, int nb_var, int nb_elem, unsigned int pw_base_limi
   delete Sys;
 }
 
-unsigned int TestClasses [][4]=
-  //Nbcnst Nbvar Baselimit Maxlimit
-  {{  10  ,10    ,1        ,2 }, //small
-   {  100 ,100   ,3        ,6 }, //medium
-   {  2000,2000  ,5        ,8 }, //big
-   { 20000,20000 ,7        ,10}  //huge
+unsigned int TestClasses [][5]=
+  //Nbcnst Nbvar Baselimit Maxlimit Nbelem (0: depends on the limits)
+  {{  10  ,10    ,1        ,2       ,0}, //small
+   {  100 ,100   ,3        ,6       ,0}, //medium
+   {  2000,2000  ,5        ,8       ,0}, //big
+   { 20000,20000 ,7        ,10      ,0}, //huge
+   {  2000,800   ,1        ,2       ,2}  //sparse: many small independent components
   };
 
 int main(int argc, char **argv)
@@ -125,7 +245,7 @@ int main(int argc, char **argv)
   int testclass;
 
   if(argc<3) {
-    fprintf(stderr, "Syntax: <small|medium|big|huge> <count> [test|debug|perf]\n");
+    fprintf(stderr, "Syntax: <small|medium|big|huge|sparse> <count> [test|debug|perf|compare|perf-array|incremental]\n");
     return -1;
   }
 
@@ -138,6 +258,8 @@ int main(int argc, char **argv)
     testclass = 2;
   else if (not strcmp(argv[1], "huge"))
     testclass = 3;
+  else if (not strcmp(argv[1], "sparse"))
+    testclass = 4;
   else {
     fprintf(stderr, "Unknown class \"%s\", aborting!\n",argv[1]);
     return -2;
@@ -154,6 +276,12 @@ int main(int argc, char **argv)
     mode=2;
   if(argc>=4 && strcmp(argv[3],"perf")==0)
     mode=3;
+  if (argc >= 4 && strcmp(argv[3], "compare") == 0)
+    mode = 4;
+  if (argc >= 4 && strcmp(argv[3], "perf-array") == 0)
+    mode = 5;
+  if (argc >= 4 && strcmp(argv[3], "incremental") == 0)
+    mode = 6;
 
   if(mode==1)
     xbt_log_control_set("surf/maxmin.threshold:DEBUG surf/maxmin.fmt:\'[%r]: [%c/%p] %m%n\' "
@@ -172,6 +300,8 @@ int main(int argc, char **argv)
   unsigned int nb_elem= (1<<pw_base_limit)+(1<<(8*pw_max_limit/10));
   //Otherwise, just set it to a constant value (and set rate_no_limit to 1.0):
   //nb_elem=200
+  if (TestClasses[testclass][4] > 0)
+    nb_elem = TestClasses[testclass][4];
 
   for(int i=0;i<testcount;i++){
     seedx=i+1;
@@ -188,7 +318,7 @@ int main(int argc, char **argv)
                   "%u variables with %u active constraint each, concurrency in [%i,%i] and max concurrency share %u\n",
           testcount, nb_cnst, nb_var, nb_elem, (1 << pw_base_limit), (1 << pw_base_limit) + (1 << pw_max_limit),
           max_share);
-  if(mode==3)
+  if (mode == 3 || mode == 5)
     fprintf(stderr, "Execution time: %g +- %g  microseconds \n",mean_date, stdev_date);
 
   return 0;
@@ -15,7 +15,7 @@
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(parmap_bench, "Bench for parmap");
 
-constexpr unsigned MODES_DEFAULT = 0x7;
+constexpr unsigned MODES_DEFAULT = 0x17;
 constexpr unsigned ARRAY_SIZE    = 10007;
 constexpr unsigned FIBO_MAX      = 25;
 
@@ -37,6 +37,9 @@ static std::string parmap_mode_name(e_xbt_parmap_mode_t mode)
     case XBT_PARMAP_DEFAULT:
       name = "DEFAULT";
       break;
+    case XBT_PARMAP_WORK_STEALING:
+      name = "WORK_STEALING";
+      break;
     default:
       name = "UNKNOWN(" + std::to_string(mode) + ")";
       break;
@@ -98,7 +101,7 @@ static void bench_parmap(int nthreads, double timeout, e_xbt_parmap_mode_t mode,
 static void bench_all_modes(int nthreads, double timeout, unsigned modes, bool full_bench)
 {
   std::vector<e_xbt_parmap_mode_t> all_modes = {XBT_PARMAP_POSIX, XBT_PARMAP_FUTEX, XBT_PARMAP_BUSY_WAIT,
-                                                XBT_PARMAP_DEFAULT};
+                                                XBT_PARMAP_DEFAULT, XBT_PARMAP_WORK_STEALING};
 
   for (unsigned i = 0; i < all_modes.size(); i++) {
     if (1U << i & modes)
@@ -119,7 +122,7 @@ int main(int argc, char* argv[])
     XBT_INFO("Usage: %s nthreads timeout [modes]", argv[0]);
     XBT_INFO("    nthreads - number of working threads");
     XBT_INFO("    timeout  - max duration for each test");
-    XBT_INFO("    modes    - bitmask of modes to test");
+    XBT_INFO("    modes    - bitmask of modes to test (posix=1, futex=2, busy_wait=4, default=8, work_stealing=16)");
     return EXIT_FAILURE;
   }
   nthreads = atoi(argv[1]);
@@ -129,7 +132,7 @@ int main(int argc, char* argv[])
   }
   timeout = atof(argv[2]);
   if (argc == 4)
-    modes = strtol(argv[2], NULL, 0);
+    modes = strtol(argv[3], NULL, 0);
 
   XBT_INFO("Parmap benchmark with %d workers (modes = %#x)...", nthreads, modes);
   XBT_INFO("%s", "");
@@ -99,6 +99,8 @@ int main(int argc, char** argv)
 #endif
   XBT_INFO("Basic testing busy wait");
   status += test_parmap_basic(XBT_PARMAP_BUSY_WAIT);
+  XBT_INFO("Basic testing work stealing");
+  status += test_parmap_basic(XBT_PARMAP_WORK_STEALING);
 
   XBT_INFO("Extended testing posix");
   status += test_parmap_extended(XBT_PARMAP_POSIX);
@@ -108,6 +110,8 @@ int main(int argc, char** argv)
 #endif
   XBT_INFO("Extended testing busy wait");
   status += test_parmap_extended(XBT_PARMAP_BUSY_WAIT);
+  XBT_INFO("Extended testing work stealing");
+  status += test_parmap_extended(XBT_PARMAP_WORK_STEALING);
 
   return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -9,6 +9,7 @@ set(EXTRA_DIST
   src/include/surf/surf.hpp
   src/include/xbt/coverage.h
   src/include/xbt/parmap.hpp
+  src/include/xbt/slab.hpp
   src/include/xbt/mmalloc.h
   src/include/catch.hpp
   src/mc/mc_mmu.hpp
@@ -205,6 +206,7 @@ set(SMPI_SRC
   src/smpi/colls/scatter/scatter-ompi.cpp
   src/smpi/colls/scatter/scatter-mvapich-two-level.cpp
   src/smpi/colls/smpi_nbc_impl.cpp
+  src/smpi/colls/smpi_analytic_colls.cpp
   src/smpi/colls/smpi_automatic_selector.cpp
   src/smpi/colls/smpi_default_selector.cpp
   src/smpi/colls/smpi_mpich_selector.cpp
@@ -281,6 +283,7 @@ set(XBT_SRC
   src/xbt/memory_map.hpp
   src/xbt/OsSemaphore.hpp
   src/xbt/parmap.cpp
+  src/xbt/slab.cpp
   src/xbt/snprintf.c
   src/xbt/string.cpp
   src/xbt/xbt_log_appender_file.cpp
@@ -304,6 +307,7 @@ set(NS3_SRC  src/surf/network_ns3.cpp
              src/surf/ns3/ns3_simulator.cpp )
 
 set(SURF_SRC
+  src/kernel/lmm/array_maxmin.cpp
   src/kernel/lmm/fair_bottleneck.cpp
   src/kernel/lmm/lagrange.cpp
   src/kernel/lmm/maxmin.hpp
@@ -324,6 +328,8 @@ set(SURF_SRC
   src/kernel/routing/FullZone.cpp
   src/kernel/routing/NetPoint.cpp
   src/kernel/routing/NetZoneImpl.cpp
+  src/kernel/routing/RouteCache.cpp
+  src/kernel/routing/RouteCache.hpp
   src/kernel/routing/TorusZone.cpp
   src/kernel/routing/RoutedZone.cpp
   src/kernel/routing/VivaldiZone.cpp
@@ -379,14 +385,20 @@ set(SIMIX_SRC
   src/kernel/context/Context.hpp
   src/kernel/context/ContextRaw.cpp
   src/kernel/context/ContextRaw.hpp
+  src/kernel/context/ContextStackless.cpp
+  src/kernel/context/ContextStackless.hpp
   src/kernel/context/ContextSwapped.cpp
   src/kernel/context/ContextSwapped.hpp
+  src/kernel/context/StackPool.cpp
+  src/kernel/context/StackPool.hpp
   src/kernel/context/ContextThread.cpp
   src/kernel/context/ContextThread.hpp
   src/simix/smx_deployment.cpp
   src/simix/smx_environment.cpp
   src/simix/smx_global.cpp
   src/simix/popping.cpp
+  src/simix/TimerWheel.cpp
+  src/simix/TimerWheel.hpp
   src/kernel/activity/ActivityImpl.cpp
   src/kernel/activity/ActivityImpl.hpp
   src/kernel/activity/ConditionVariableImpl.cpp
@@ -1032,6 +1044,7 @@ set(CMAKEFILES_TXT
 
   tools/CMakeLists.txt
   tools/graphicator/CMakeLists.txt
+  tools/profile_converter/CMakeLists.txt
   tools/tesh/CMakeLists.txt
   )
 
@@ -0,0 +1,31 @@
+/* Copyright (c) 2019. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Converts a profile from the text format to the binary format, that SimGrid maps in memory instead of parsing it */
+
+#include "simgrid/s4u/Engine.hpp"
+#include "src/kernel/resource/profile/trace_mgr.hpp"
+
+#include <algorithm>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(profile_converter, "Profile converter");
+
+int main(int argc, char** argv)
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc == 3, "Usage: %s <text_profile> <binary_profile>", argv[0]);
+
+  simgrid::kernel::profile::Profile* profile = simgrid::kernel::profile::Profile::from_file(argv[1]);
+  profile->write_binary(argv[2]);
+
+  /* Load the file that we just wrote, to check that it holds the same values */
+  auto events     = profile->get_events();
+  auto new_events = simgrid::kernel::profile::Profile::from_file(argv[2])->get_events();
+  xbt_assert(events.size() == new_events.size() && std::equal(events.begin(), events.end(), new_events.begin()),
+             "The binary profile %s differs from %s", argv[2], argv[1]);
+
+  XBT_INFO("Converted %zu dated values to %s", events.size(), argv[2]);
+  return 0;
+}